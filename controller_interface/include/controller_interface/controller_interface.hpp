@@ -70,6 +70,14 @@ public:
   CONTROLLER_INTERFACE_PUBLIC
   virtual InterfaceConfiguration state_interface_configuration() const = 0;
 
+  /// Assign the loaned interfaces the controller uses until release_interfaces is called.
+  /**
+   * All interfaces are checked to reference a value. The controller can use the unchecked
+   * real-time accessors of the loaned interfaces of type double in update, interfaces of other
+   * types are accessed through their typed accessors.
+   * \throws std::runtime_error if an interface does not reference a value, nothing is assigned
+   * then.
+   */
   CONTROLLER_INTERFACE_PUBLIC
   void assign_interfaces(
     std::vector<hardware_interface::LoanedCommandInterface> && command_interfaces,
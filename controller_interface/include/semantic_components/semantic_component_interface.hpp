@@ -75,23 +75,56 @@ public:
 
   /// Return all values.
   /**
-   * \return true if it gets all the values, else false
+   * Array interfaces contribute all of their values.
+   * \return true if it gets all the values, else false, also if an interface does not reference
+   * doubles.
    */
   bool get_values(std::vector<double> & values) const
   {
+    size_t count = 0;
+    for (const auto & state_interface : state_interfaces_)
+    {
+      if (!state_interface.get().has_value())
+      {
+        return false;
+      }
+      count += state_interface.get().get_size();
+    }
     // check we have sufficient memory
-    if (values.capacity() != state_interfaces_.size())
+    if (values.capacity() != count)
     {
       return false;
     }
     // insert all the values
-    for (size_t i = 0; i < state_interfaces_.size(); ++i)
+    for (const auto & state_interface : state_interfaces_)
     {
-      values.emplace_back(state_interfaces_[i].get().get_value());
+      if (state_interface.get().get_size() == 1)
+      {
+        values.emplace_back(state_interface.get().get_value());
+      }
+      else
+      {
+        const auto array_values = state_interface.get().get_values();
+        values.insert(values.end(), array_values.begin(), array_values.end());
+      }
     }
     return true;
   }
 
+  /// Return the values of the state interface at \p index without copying them.
+  /**
+   * Meant for array interfaces, e.g., of tactile sensors, whose values are read as one block.
+   * \return view of the values, empty if \p index is out of range or the interface has no values.
+   */
+  hardware_interface::Span<const double> get_values_span(size_t index = 0) const
+  {
+    if (index >= state_interfaces_.size())
+    {
+      return {};
+    }
+    return state_interfaces_[index].get().get_values();
+  }
+
   /// Return values as MessageReturnType
   /**
    * \return false by default
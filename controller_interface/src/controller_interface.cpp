@@ -15,6 +15,7 @@
 #include "controller_interface/controller_interface.hpp"
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -82,6 +83,29 @@ void ControllerInterface::assign_interfaces(
   std::vector<hardware_interface::LoanedCommandInterface> && command_interfaces,
   std::vector<hardware_interface::LoanedStateInterface> && state_interfaces)
 {
+  // double values have to be accessible by the unchecked accessors
+  const auto references_value = [](const auto & interface) {
+    return interface.get_data_type() == hardware_interface::HandleDataType::DOUBLE
+             ? interface.has_value()
+             : interface.has_data();
+  };
+  for (const auto & interface : command_interfaces)
+  {
+    if (!references_value(interface))
+    {
+      throw std::runtime_error(
+        "Command interface '" + interface.get_full_name() + "' does not reference a value");
+    }
+  }
+  for (const auto & interface : state_interfaces)
+  {
+    if (!references_value(interface))
+    {
+      throw std::runtime_error(
+        "State interface '" + interface.get_full_name() + "' does not reference a value");
+    }
+  }
+
   command_interfaces_ = std::forward<decltype(command_interfaces)>(command_interfaces);
   state_interfaces_ = std::forward<decltype(state_interfaces)>(state_interfaces);
 }
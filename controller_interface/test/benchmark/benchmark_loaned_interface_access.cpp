@@ -0,0 +1,93 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "hardware_interface/handle.hpp"
+#include "hardware_interface/loaned_command_interface.hpp"
+#include "hardware_interface/loaned_state_interface.hpp"
+
+namespace
+{
+constexpr size_t kJointCount = 1000;
+
+/// Loaned state and command interfaces of kJointCount joints, as a controller gets them.
+class Joints
+{
+public:
+  Joints() : state_values_(kJointCount, 1.0), command_values_(kJointCount, 0.0)
+  {
+    state_handles_.reserve(kJointCount);
+    command_handles_.reserve(kJointCount);
+    for (size_t i = 0; i < kJointCount; ++i)
+    {
+      const auto name = "joint" + std::to_string(i);
+      state_handles_.emplace_back(name, "position", &state_values_[i]);
+      command_handles_.emplace_back(name, "position", &command_values_[i]);
+    }
+    state_interfaces.reserve(kJointCount);
+    command_interfaces.reserve(kJointCount);
+    for (size_t i = 0; i < kJointCount; ++i)
+    {
+      state_interfaces.emplace_back(state_handles_[i]);
+      command_interfaces.emplace_back(command_handles_[i]);
+    }
+  }
+
+  std::vector<hardware_interface::LoanedStateInterface> state_interfaces;
+  std::vector<hardware_interface::LoanedCommandInterface> command_interfaces;
+
+private:
+  std::vector<double> state_values_;
+  std::vector<double> command_values_;
+  std::vector<hardware_interface::StateInterface> state_handles_;
+  std::vector<hardware_interface::CommandInterface> command_handles_;
+};
+}  // namespace
+
+/// Update of a controller commanding each joint its state, using the checked accessors.
+static void BM_checked_access(benchmark::State & state)
+{
+  Joints joints;
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < kJointCount; ++i)
+    {
+      joints.command_interfaces[i].set_value(joints.state_interfaces[i].get_value() + 0.1);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kJointCount);
+}
+BENCHMARK(BM_checked_access);
+
+/// Same update using the real-time accessors, which use the pointers resolved on loaning.
+static void BM_unchecked_access(benchmark::State & state)
+{
+  Joints joints;
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < kJointCount; ++i)
+    {
+      joints.command_interfaces[i].set_value_unchecked(
+        joints.state_interfaces[i].get_value_unchecked() + 0.1);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kJointCount);
+}
+BENCHMARK(BM_unchecked_access);
@@ -15,12 +15,15 @@
 #include "test_controller_with_options.hpp"
 #include <gtest/gtest.h>
 #include <string>
+#include <utility>
+#include <vector>
 #include "rclcpp/rclcpp.hpp"
 
 class FriendControllerWithOptions : public controller_with_options::ControllerWithOptions
 {
   FRIEND_TEST(ControllerWithOption, init_with_overrides);
   FRIEND_TEST(ControllerWithOption, init_without_overrides);
+  FRIEND_TEST(ControllerWithOption, assign_typed_interfaces);
 };
 
 template <class T, size_t N>
@@ -70,3 +73,39 @@ TEST(ControllerWithOption, init_without_overrides)
   EXPECT_EQ(controller.params.size(), 0u);
   rclcpp::shutdown();
 }
+
+TEST(ControllerWithOption, assign_typed_interfaces)
+{
+  bool flag = true;
+  int32_t mode = 2;
+  double position = 1.5;
+  hardware_interface::CommandInterface flag_handle{"gripper", "open", &flag};
+  hardware_interface::StateInterface mode_handle{"gripper", "mode", &mode};
+  hardware_interface::StateInterface position_handle{"gripper", "position", &position};
+
+  FriendControllerWithOptions controller;
+  std::vector<hardware_interface::LoanedCommandInterface> command_interfaces;
+  command_interfaces.emplace_back(flag_handle);
+  std::vector<hardware_interface::LoanedStateInterface> state_interfaces;
+  state_interfaces.emplace_back(mode_handle);
+  state_interfaces.emplace_back(position_handle);
+  ASSERT_NO_THROW(
+    controller.assign_interfaces(std::move(command_interfaces), std::move(state_interfaces)));
+  ASSERT_EQ(1u, controller.command_interfaces_.size());
+  ASSERT_EQ(2u, controller.state_interfaces_.size());
+
+  // typed values are accessed through the typed accessors, only doubles are unchecked
+  EXPECT_FALSE(controller.command_interfaces_[0].has_value());
+  controller.command_interfaces_[0].set_typed_value(false);
+  EXPECT_FALSE(flag);
+  EXPECT_EQ(2, controller.state_interfaces_[0].get_typed_value<int32_t>());
+  ASSERT_TRUE(controller.state_interfaces_[1].has_value());
+  EXPECT_DOUBLE_EQ(1.5, controller.state_interfaces_[1].get_value_unchecked());
+
+  // interfaces without value are rejected
+  hardware_interface::StateInterface empty_handle{"gripper", "effort"};
+  std::vector<hardware_interface::LoanedStateInterface> empty_state_interfaces;
+  empty_state_interfaces.emplace_back(empty_handle);
+  EXPECT_THROW(
+    controller.assign_interfaces({}, std::move(empty_state_interfaces)), std::runtime_error);
+}
@@ -133,3 +133,52 @@ TEST_F(SemanticComponentInterfaceTest, validate_state_interfaces)
     semantic_component_->interface_names_.begin(), semantic_component_->interface_names_.end(),
     interface_names.begin(), interface_names.end()));
 }
+
+TEST_F(SemanticComponentInterfaceTest, validate_array_state_interfaces)
+{
+  // create 'test_component' with a single interface holding all taxels of a tactile sensor
+  semantic_component_ = std::make_unique<TestableSemanticComponentInterface>(component_name_, 1);
+  semantic_component_->get_state_interface_names();
+
+  std::vector<double> taxels = {0.1, 0.2, 0.3, 0.4};
+  hardware_interface::StateInterface interface_1{
+    component_name_, "1", taxels.data(), taxels.size()};
+  std::vector<hardware_interface::LoanedStateInterface> temp_state_interfaces;
+  temp_state_interfaces.emplace_back(interface_1);
+  ASSERT_TRUE(semantic_component_->assign_loaned_state_interfaces(temp_state_interfaces));
+
+  // the values are read as one block without copying them
+  const auto span = semantic_component_->get_values_span();
+  ASSERT_EQ(span.size(), taxels.size());
+  EXPECT_EQ(span.data(), taxels.data());
+  taxels[2] = 3.3;
+  EXPECT_EQ(span[2], 3.3);
+  EXPECT_TRUE(semantic_component_->get_values_span(1).empty());
+
+  // get_values copies all values of array interfaces
+  std::vector<double> temp_values;
+  temp_values.reserve(taxels.size());
+  ASSERT_TRUE(semantic_component_->get_values(temp_values));
+  ASSERT_EQ(temp_values, taxels);
+}
+
+TEST_F(SemanticComponentInterfaceTest, get_values_fails_for_typed_state_interfaces)
+{
+  semantic_component_ = std::make_unique<TestableSemanticComponentInterface>(component_name_, 2);
+  semantic_component_->get_state_interface_names();
+
+  double value = 1.0;
+  bool flag = true;
+  hardware_interface::StateInterface interface_1{component_name_, "1", &value};
+  hardware_interface::StateInterface interface_2{component_name_, "2", &flag};
+  std::vector<hardware_interface::LoanedStateInterface> temp_state_interfaces;
+  temp_state_interfaces.emplace_back(interface_1);
+  temp_state_interfaces.emplace_back(interface_2);
+  ASSERT_TRUE(semantic_component_->assign_loaned_state_interfaces(temp_state_interfaces));
+
+  // a bool has no double value to return
+  std::vector<double> temp_values;
+  temp_values.reserve(2);
+  EXPECT_FALSE(semantic_component_->get_values(temp_values));
+  EXPECT_TRUE(temp_values.empty());
+}
@@ -18,7 +18,9 @@ from .controller_manager_services import (
     list_controllers,
     list_hardware_interfaces,
     load_controller,
+    load_controllers,
     reload_controller_libraries,
+    set_active_controllers,
     switch_controllers,
     unload_controller
 )
@@ -29,7 +31,9 @@ __all__ = [
     'list_controllers',
     'list_hardware_interfaces',
     'load_controller',
+    'load_controllers',
     'reload_controller_libraries',
+    'set_active_controllers',
     'switch_controllers',
     'unload_controller',
 ]
@@ -14,7 +14,8 @@
 
 from controller_manager_msgs.srv import ConfigureController, \
     ListControllers, ListControllerTypes, ListHardwareInterfaces, \
-    LoadController, ReloadControllerLibraries, SwitchController, UnloadController
+    LoadController, LoadControllers, ReloadControllerLibraries, SetActiveControllers, \
+    SwitchController, UnloadController
 
 import rclpy
 
@@ -70,6 +71,13 @@ def load_controller(node, controller_manager_name, controller_name):
                           LoadController, request)
 
 
+def load_controllers(node, controller_manager_name, controller_names):
+    request = LoadControllers.Request()
+    request.names = controller_names
+    return service_caller(node, f'{controller_manager_name}/load_controllers',
+                          LoadControllers, request)
+
+
 def reload_controller_libraries(node, controller_manager_name, force_kill):
     request = ReloadControllerLibraries.Request()
     request.force_kill = force_kill
@@ -78,6 +86,22 @@ def reload_controller_libraries(node, controller_manager_name, force_kill):
                           ReloadControllerLibraries, request)
 
 
+def set_active_controllers(node, controller_manager_name, active_controllers,
+                           inactive_controllers, exclusive, strict, start_asap, timeout):
+    request = SetActiveControllers.Request()
+    request.active_controllers = active_controllers
+    request.inactive_controllers = inactive_controllers
+    request.exclusive = exclusive
+    if strict:
+        request.strictness = SetActiveControllers.Request.STRICT
+    else:
+        request.strictness = SetActiveControllers.Request.BEST_EFFORT
+    request.start_asap = start_asap
+    request.timeout = rclpy.duration.Duration(seconds=timeout).to_msg()
+    return service_caller(node, f'{controller_manager_name}/set_active_controllers',
+                          SetActiveControllers, request)
+
+
 def switch_controllers(node, controller_manager_name, stop_controllers,
                        start_controllers, strict, start_asap, timeout):
     request = SwitchController.Request()
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+# Copyright 2022 ros2_control Development Team
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Convert an interface recording of the controller manager to CSV."""
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b'ROS2CREC'
+FORMAT_VERSION = 2
+
+# layouts of InterfaceRecorder::FileHeader, InterfaceHeader and RecordHeader
+FILE_HEADER = struct.Struct('=8sIIQQQQQ')
+INTERFACE_HEADER = struct.Struct('=QIBBH')
+RECORD_HEADER = struct.Struct('=qqqq')
+
+# struct formats of hardware_interface::HandleDataType in the order of the enum
+DATA_TYPE_FORMATS = ['d', '?', 'b', 'B', 'h', 'H', 'i', 'I', 'q', 'Q']
+VALUE_SIZE = 8
+
+
+def read_recording(data):
+    """Return the column names and rows of the records in chronological order."""
+    (magic, format_version, interface_count, records_offset, record_size, capacity, value_count,
+     record_count) = FILE_HEADER.unpack_from(data, 0)
+    if magic != MAGIC or format_version != FORMAT_VERSION:
+        raise ValueError('Not an interface recording of format version %d' % FORMAT_VERSION)
+
+    interfaces = []
+    offset = FILE_HEADER.size
+    for _ in range(interface_count):
+        index, size, data_type, is_command, name_length = INTERFACE_HEADER.unpack_from(
+            data, offset)
+        offset += INTERFACE_HEADER.size
+        name = data[offset:offset + name_length].decode()
+        offset += name_length
+        name = ('command/' if is_command else 'state/') + name
+        interfaces.append((name, index, size, DATA_TYPE_FORMATS[data_type]))
+
+    columns = ['cycle', 'stamp', 'read_time', 'update_time', 'write_time']
+    for name, _, size, _ in interfaces:
+        columns += [name] if size == 1 else ['%s[%d]' % (name, i) for i in range(size)]
+
+    rows = []
+    # the ring holds the last records, the oldest one follows the newest one
+    for cycle in range(max(0, record_count - capacity), record_count):
+        record_offset = records_offset + (cycle % capacity) * record_size
+        row = [cycle] + list(RECORD_HEADER.unpack_from(data, record_offset))
+        values_offset = record_offset + RECORD_HEADER.size
+        for _, index, size, value_format in interfaces:
+            for i in range(size):
+                if index + i >= value_count:
+                    break
+                row.append(struct.unpack_from(
+                    '=' + value_format, data, values_offset + (index + i) * VALUE_SIZE)[0])
+        rows.append(row)
+    return columns, rows
+
+
+def main(args=None):
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('recording', help='File written by the interface recorder')
+    parser.add_argument(
+        '-o', '--output', help='CSV file to write, standard output if not given', default=None)
+    args = parser.parse_args(args)
+
+    with open(args.recording, 'rb') as recording:
+        columns, rows = read_recording(recording.read())
+
+    output = open(args.output, 'w', newline='') if args.output else sys.stdout
+    try:
+        writer = csv.writer(output)
+        writer.writerow(columns)
+        writer.writerows(rows)
+    finally:
+        if args.output:
+            output.close()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -22,7 +22,7 @@ import time
 import warnings
 
 from controller_manager import configure_controller, list_controllers, \
-    load_controller, switch_controllers, unload_controller
+    load_controllers, set_active_controllers, unload_controller
 
 import rclpy
 from rclpy.duration import Duration
@@ -76,7 +76,7 @@ def main(args=None):
     rclpy.init(args=args)
     parser = argparse.ArgumentParser()
     parser.add_argument(
-        'controller_name', help='Name of the controller')
+        'controller_names', help='Names of the controllers, started together', nargs='+')
     parser.add_argument(
         '-c', '--controller-manager', help='Name of the controller manager ROS node',
         default='/controller_manager', required=False)
@@ -104,7 +104,7 @@ def main(args=None):
 
     command_line_args = rclpy.utilities.remove_ros_args(args=sys.argv)[1:]
     args = parser.parse_args(command_line_args)
-    controller_name = args.controller_name
+    controller_names = args.controller_names
     controller_manager_name = make_absolute(args.controller_manager)
     param_file = args.param_file
     controller_type = args.controller_type
@@ -113,56 +113,68 @@ def main(args=None):
     if param_file and not os.path.isfile(param_file):
         raise FileNotFoundError(errno.ENOENT, os.strerror(errno.ENOENT), param_file)
 
-    node = Node('spawner_' + controller_name)
+    node = Node('spawner_' + controller_names[0])
     try:
         if not wait_for_controller_manager(node, controller_manager_name,
                                            controller_manager_timeout):
             node.get_logger().error('Controller manager not available')
             return 1
 
-        if is_controller_loaded(node, controller_manager_name, controller_name):
-            node.get_logger().info('Controller already loaded, skipping load_controller')
-        else:
-            if controller_type:
-                ret = subprocess.run(['ros2', 'param', 'set', controller_manager_name,
-                                      controller_name + '.type', controller_type])
-            ret = load_controller(
-                node, controller_manager_name, controller_name)
+        controllers_to_load = []
+        for controller_name in controller_names:
+            if is_controller_loaded(node, controller_manager_name, controller_name):
+                node.get_logger().info(
+                    'Controller ' + controller_name + ' already loaded, skipping load_controller')
+            else:
+                if controller_type:
+                    ret = subprocess.run(['ros2', 'param', 'set', controller_manager_name,
+                                          controller_name + '.type', controller_type])
+                controllers_to_load.append(controller_name)
+
+        if controllers_to_load:
+            # the controller manager initializes the controllers concurrently
+            ret = load_controllers(node, controller_manager_name, controllers_to_load)
             if not ret.ok:
                 # Error message printed by ros2 control
                 return 1
-            node.get_logger().info(bcolors.OKBLUE + 'Loaded ' + controller_name + bcolors.ENDC)
+            node.get_logger().info(
+                bcolors.OKBLUE + 'Loaded ' + ', '.join(controllers_to_load) + bcolors.ENDC)
 
         if param_file:
-            ret = subprocess.run(['ros2', 'param', 'load', controller_name,
-                                  param_file])
-            if ret.returncode != 0:
-                # Error message printed by ros2 param
-                return ret.returncode
-            node.get_logger().info('Loaded ' + param_file + ' into ' + controller_name)
+            for controller_name in controller_names:
+                ret = subprocess.run(['ros2', 'param', 'load', controller_name,
+                                      param_file])
+                if ret.returncode != 0:
+                    # Error message printed by ros2 param
+                    return ret.returncode
+                node.get_logger().info('Loaded ' + param_file + ' into ' + controller_name)
 
         if not args.load_only:
-            ret = configure_controller(
-                node, controller_manager_name, controller_name)
-            if not ret.ok:
-                node.get_logger().info('Failed to configure controller')
-                return 1
-
-            if not args.stopped:
-                ret = switch_controllers(
+            if args.stopped:
+                for controller_name in controller_names:
+                    ret = configure_controller(
+                        node, controller_manager_name, controller_name)
+                    if not ret.ok:
+                        node.get_logger().info('Failed to configure controller')
+                        return 1
+            else:
+                # the controller manager configures and starts all controllers in one switch
+                ret = set_active_controllers(
                     node,
                     controller_manager_name,
+                    controller_names,
                     [],
-                    [controller_name],
+                    False,
                     True,
                     True,
                     5.0)
                 if not ret.ok:
-                    node.get_logger().info('Failed to start controller')
+                    node.get_logger().info('Failed to configure and start controllers')
                     return 1
 
                 node.get_logger().info(bcolors.OKGREEN + 'Configured and started ' +
-                                       bcolors.OKCYAN + controller_name + bcolors.ENDC)
+                                       bcolors.OKCYAN + ', '.join(controller_names) +
+                                       bcolors.ENDC)
 
         if not args.unload_on_kill:
             return 0
@@ -173,28 +185,30 @@ def main(args=None):
                 time.sleep(1)
         except KeyboardInterrupt:
             if not args.stopped:
-                node.get_logger().info('Interrupt captured, stopping and unloading controller')
-                ret = switch_controllers(
+                node.get_logger().info('Interrupt captured, stopping and unloading controllers')
+                ret = set_active_controllers(
                     node,
                     controller_manager_name,
-                    [controller_name],
                     [],
+                    controller_names,
+                    False,
                     True,
                     True,
                     5.0)
                 if not ret.ok:
-                    node.get_logger().info('Failed to stop controller')
+                    node.get_logger().info('Failed to stop controllers')
                     return 1
 
-                node.get_logger().info('Stopped controller')
+                node.get_logger().info('Stopped controllers')
 
-            ret = unload_controller(
-                node, controller_manager_name, controller_name)
-            if not ret.ok:
-                node.get_logger().info('Failed to unload controller')
-                return 1
+            for controller_name in controller_names:
+                ret = unload_controller(
+                    node, controller_manager_name, controller_name)
+                if not ret.ok:
+                    node.get_logger().info('Failed to unload controller')
+                    return 1
 
-            node.get_logger().info('Unloaded controller')
+                node.get_logger().info('Unloaded controller ' + controller_name)
         return 0
     finally:
         rclpy.shutdown()
@@ -15,7 +15,10 @@
 #ifndef CONTROLLER_MANAGER__CONTROLLER_MANAGER_HPP_
 #define CONTROLLER_MANAGER__CONTROLLER_MANAGER_HPP_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -23,7 +26,13 @@
 #include "controller_interface/controller_interface.hpp"
 
 #include "controller_manager/controller_spec.hpp"
+#include "controller_manager/interface_recorder.hpp"
+#include "controller_manager/latency_histogram.hpp"
+#include "controller_manager/loop_scheduler.hpp"
+#include "controller_manager/realtime_notifier.hpp"
 #include "controller_manager/visibility_control.h"
+#include "controller_manager/worker_pool.hpp"
+#include "controller_manager_msgs/msg/cycle_statistics.hpp"
 #include "controller_manager_msgs/srv/configure_controller.hpp"
 #include "controller_manager_msgs/srv/configure_start_controller.hpp"
 #include "controller_manager_msgs/srv/list_controller_types.hpp"
@@ -32,8 +41,10 @@
 #include "controller_manager_msgs/srv/list_hardware_interfaces.hpp"
 #include "controller_manager_msgs/srv/load_configure_controller.hpp"
 #include "controller_manager_msgs/srv/load_controller.hpp"
+#include "controller_manager_msgs/srv/load_controllers.hpp"
 #include "controller_manager_msgs/srv/load_start_controller.hpp"
 #include "controller_manager_msgs/srv/reload_controller_libraries.hpp"
+#include "controller_manager_msgs/srv/set_active_controllers.hpp"
 #include "controller_manager_msgs/srv/set_hardware_component_state.hpp"
 #include "controller_manager_msgs/srv/switch_controller.hpp"
 #include "controller_manager_msgs/srv/unload_controller.hpp"
@@ -44,6 +55,8 @@
 
 #include "rclcpp/executor.hpp"
 #include "rclcpp/node.hpp"
+#include "rclcpp/publisher.hpp"
+#include "rclcpp/timer.hpp"
 
 namespace controller_manager
 {
@@ -86,6 +99,21 @@ public:
   controller_interface::ControllerInterfaceSharedPtr load_controller(
     const std::string & controller_name);
 
+  /// load_controllers loads several controllers by name concurrently.
+  /**
+   * The plugins are created one after another, but the controllers are initialized in parallel
+   * on a pool of threads, which are joined before returning. Only adding the initialized
+   * controllers to the controller list is serialized.
+   * \param[in] controller_names names of the controllers, their types must be defined in the
+   * parameter server.
+   * \return the controllers in the order of \p controller_names, nullptr for the ones which
+   * could not be loaded.
+   * \see Documentation in controller_manager_msgs/LoadControllers.srv
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  std::vector<controller_interface::ControllerInterfaceSharedPtr> load_controllers(
+    const std::vector<std::string> & controller_names);
+
   CONTROLLER_MANAGER_PUBLIC
   controller_interface::return_type unload_controller(const std::string & controller_name);
 
@@ -118,9 +146,17 @@ public:
 
   /// switch_controller Stops some controllers and start others.
   /**
+   * The started controllers are updated once the hardware completed the mode switch of their
+   * command interfaces, see hardware_interface::ResourceManager::is_command_mode_switch_done().
    * \param[in] start_controllers is a list of controllers to start
    * \param[in] stop_controllers is a list of controllers to stop
    * \param[in] set level of strictness (BEST_EFFORT or STRICT)
+   * \param[in] start_asap update each started controller as soon as the mode switch of its own
+   * interfaces is completed, otherwise all started controllers are updated in the same cycle.
+   * \param[in] timeout for the mode switch, started controllers whose interfaces did not complete
+   * it are deactivated again. Zero for the command_mode_switch_timeout parameter. Started
+   * controllers are also deactivated if the hardware failed to perform the mode switch. The rest
+   * of the switch is not undone, also if this fails a STRICT switch.
    * \see Documentation in controller_manager_msgs/SwitchController.srv
    */
   CONTROLLER_MANAGER_PUBLIC
@@ -130,6 +166,33 @@ public:
     bool start_asap = kWaitForAllResources,
     const rclcpp::Duration & timeout = rclcpp::Duration::from_nanoseconds(kInfiniteTimeout));
 
+  /// set_active_controllers Switches to a target configuration of active controllers at once.
+  /**
+   * Only the controllers which are not in their target state yet are switched, all of them with
+   * one switch_controller(). Unconfigured controllers to activate are configured before.
+   * \param[in] active_controllers is a list of controllers which shall be active
+   * \param[in] inactive_controllers is a list of controllers which shall be inactive
+   * \param[in] exclusive stop all other active controllers as well
+   * \param[out] started_controllers the controllers which were started
+   * \param[out] stopped_controllers the controllers which were stopped
+   * \see Documentation in controller_manager_msgs/SetActiveControllers.srv
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  controller_interface::return_type set_active_controllers(
+    const std::vector<std::string> & active_controllers,
+    const std::vector<std::string> & inactive_controllers, bool exclusive, int strictness,
+    bool start_asap, const rclcpp::Duration & timeout,
+    std::vector<std::string> & started_controllers,
+    std::vector<std::string> & stopped_controllers);
+
+  /// Whether a prepared controller switch waits to be committed by the update loop.
+  /**
+   * switch_controller() prepares a switch and waits until the next update() commits it, at the
+   * beginning of the cycle. Real-time safe.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  bool is_switch_pending() const;
+
   CONTROLLER_MANAGER_PUBLIC
   void read();
 
@@ -153,26 +216,84 @@ public:
   CONTROLLER_MANAGER_PUBLIC
   unsigned int get_update_rate() const;
 
+  /// Scheduler of the real-time update loop at the update rate.
+  /**
+   * The loop driving read(), update() and write() sleeps with it, so its missed deadlines are
+   * published with the cycle statistics.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  LoopScheduler & get_loop_scheduler();
+
 protected:
   CONTROLLER_MANAGER_PUBLIC
   void init_services();
 
+  CONTROLLER_MANAGER_PUBLIC
+  void init_cycle_statistics();
+
+  CONTROLLER_MANAGER_PUBLIC
+  void init_worker_pool();
+
+  CONTROLLER_MANAGER_PUBLIC
+  void init_hardware_read_write();
+
+  CONTROLLER_MANAGER_PUBLIC
+  void init_interface_recorder();
+
+  CONTROLLER_MANAGER_PUBLIC
+  void init_hardware_error_handling();
+
+  /// Stop the controllers using hardware components which failed and deactivate the components,
+  /// as requested by their error policies.
+  CONTROLLER_MANAGER_PUBLIC
+  void handle_hardware_errors();
+
+  /// Drain the execution time histograms of the update loop and publish their statistics, with
+  /// the missed deadlines of the loop scheduler.
+  CONTROLLER_MANAGER_PUBLIC
+  void publish_cycle_statistics();
+
   CONTROLLER_MANAGER_PUBLIC
   controller_interface::ControllerInterfaceSharedPtr add_controller_impl(
     const ControllerSpec & controller);
 
+  /// Commit the prepared controller switch, called by the RT thread.
+  /**
+   * The controllers were already stopped and started by switch_controller(), the RT thread only
+   * performs the command mode switch of the hardware in the first cycle which updates the new
+   * controllers.
+   */
   CONTROLLER_MANAGER_PUBLIC
   void manage_switch();
 
+  /// Deactivate the requested controllers, which the RT thread no longer updates. Not RT safe.
   CONTROLLER_MANAGER_PUBLIC
   void stop_controllers();
 
+  /// Claim the interfaces of and activate the requested controllers before the RT thread updates
+  /// them. Not RT safe.
   CONTROLLER_MANAGER_PUBLIC
   void start_controllers();
 
+  /// Let the RT thread update the started controllers whose command interfaces completed the
+  /// mode switch, called by the RT thread after the switch was committed. RT safe.
+  /**
+   * With start_asap each controller is released on its own, otherwise all started controllers
+   * are released in the same cycle.
+   */
   CONTROLLER_MANAGER_PUBLIC
   void start_controllers_asap();
 
+  /// Deactivate the started controllers which are still waiting for the mode switch of their
+  /// command interfaces, after the RT thread stopped checking them. Not RT safe.
+  /**
+   * \param[in] reason why the controllers are deactivated, for the log.
+   * \return the names of the deactivated controllers.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  std::vector<std::string> roll_back_pending_starts(
+    const std::lock_guard<std::recursive_mutex> & guard, const std::string & reason);
+
   CONTROLLER_MANAGER_PUBLIC
   void list_controllers_srv_cb(
     const std::shared_ptr<controller_manager_msgs::srv::ListControllers::Request> request,
@@ -188,6 +309,11 @@ protected:
     const std::shared_ptr<controller_manager_msgs::srv::LoadController::Request> request,
     std::shared_ptr<controller_manager_msgs::srv::LoadController::Response> response);
 
+  CONTROLLER_MANAGER_PUBLIC
+  void load_controllers_service_cb(
+    const std::shared_ptr<controller_manager_msgs::srv::LoadControllers::Request> request,
+    std::shared_ptr<controller_manager_msgs::srv::LoadControllers::Response> response);
+
   CONTROLLER_MANAGER_PUBLIC
   void configure_controller_service_cb(
     const std::shared_ptr<controller_manager_msgs::srv::ConfigureController::Request> request,
@@ -218,6 +344,11 @@ protected:
     const std::shared_ptr<controller_manager_msgs::srv::SwitchController::Request> request,
     std::shared_ptr<controller_manager_msgs::srv::SwitchController::Response> response);
 
+  CONTROLLER_MANAGER_PUBLIC
+  void set_active_controllers_service_cb(
+    const std::shared_ptr<controller_manager_msgs::srv::SetActiveControllers::Request> request,
+    std::shared_ptr<controller_manager_msgs::srv::SetActiveControllers::Response> response);
+
   CONTROLLER_MANAGER_PUBLIC
   void unload_controller_service_cb(
     const std::shared_ptr<controller_manager_msgs::srv::UnloadController::Request> request,
@@ -239,7 +370,8 @@ protected:
     std::shared_ptr<controller_manager_msgs::srv::SetHardwareComponentState::Response> response);
 
   // Per controller update rate support
-  unsigned int update_loop_counter_ = 0;
+  /// Phase of the next started controller with a lower update rate, staggers their updates
+  unsigned int next_update_phase_ = 0;
   unsigned int update_rate_ = 100;
 
 private:
@@ -250,6 +382,8 @@ private:
   std::shared_ptr<rclcpp::Executor> executor_;
 
   std::shared_ptr<pluginlib::ClassLoader<controller_interface::ControllerInterface>> loader_;
+  /// Serializes the access to loader_, which is not thread-safe
+  std::mutex loader_mutex_;
 
   /// Best effort (non real-time safe) callback group, e.g., service callbacks.
   /**
@@ -268,6 +402,14 @@ private:
    *
    * The updated state changes on the switch_updated_list()
    * The rt usage state changes on the update_and_get_used_by_rt_list()
+   *
+   * Both indices are atomics. The RT thread publishes the index of the list it uses before
+   * accessing it, non-RT threads waiting for a list to become unused are notified as soon as
+   * the RT thread picked up the other one.
+   *
+   * The RT thread only accesses the copies of the active controllers cached with each list, so
+   * inactive controllers are added to the updated list in place, without waiting for the RT
+   * thread.
    */
   class RTControllerListWrapper
   {
@@ -282,6 +424,30 @@ private:
      */
     std::vector<ControllerSpec> & update_and_get_used_by_rt_list();
 
+    /// get_active_rt_list Returns the active controllers of the "used by rt" list
+    /**
+     * The active controllers are cached when a list becomes the "updated" list and after
+     * each controller switch, so the RT thread neither queries the lifecycle state of the
+     * controllers nor iterates over inactive ones.
+     * \warning Should only be called by the RT thread after update_and_get_used_by_rt_list()
+     */
+    const std::vector<ControllerSpec> & get_active_rt_list() const;
+
+    /// get_active_rt_groups Returns the groups of the active controllers of the "used by rt" list
+    /**
+     * Group i consists of the active controllers with indices in [groups[i], groups[i + 1]).
+     * Controllers of different groups have no interfaces in common and may be updated
+     * concurrently, the controllers of a group are updated in order of the list.
+     * \warning Should only be called by the RT thread after update_and_get_used_by_rt_list()
+     */
+    const std::vector<size_t> & get_active_rt_groups() const;
+
+    /// is_used_by_rt Whether the RT thread uses the list with the given index. Real-time safe.
+    bool is_used_by_rt(int index) const;
+
+    /// Split the active controllers of each new list into groups of dependent controllers
+    bool group_active_controllers = false;
+
     /**
      * get_unused_list Waits until the "outdated" and "unused by rt"
      * lists match and returns a reference to it
@@ -292,6 +458,9 @@ private:
     std::vector<ControllerSpec> & get_unused_list(
       const std::lock_guard<std::recursive_mutex> & guard);
 
+    /// get_unused_list_index Returns the index the list returned by get_unused_list() has.
+    int get_unused_list_index(const std::lock_guard<std::recursive_mutex> & guard) const;
+
     /// get_updated_list Returns a const reference to the most updated list.
     /**
      * \warning May or may not being used by the realtime thread, read-only reference for safety
@@ -300,12 +469,26 @@ private:
     const std::vector<ControllerSpec> & get_updated_list(
       const std::lock_guard<std::recursive_mutex> & guard) const;
 
+    /// add_to_updated_list Appends an inactive controller to the most updated list.
+    /**
+     * Adding an inactive controller does not change the active controllers the RT thread
+     * uses, hence the controller is appended in place and the RT thread is not waited for.
+     * \param[in] guard Guard needed to make sure the caller is the only one accessing the lists
+     * \return reference to the added controller.
+     */
+    ControllerSpec & add_to_updated_list(
+      const std::lock_guard<std::recursive_mutex> & guard, const ControllerSpec & controller);
+
     /**
      * switch_updated_list Switches the "updated" and "outdated" lists, and waits
      *  until the RT thread is using the new "updated" list.
      * \param[in] guard Guard needed to make sure the caller is the only one accessing the unused by rt list
+     * \param[in] stopped_controllers active controllers which the RT thread stops updating with
+     * the new list, so they can be deactivated without racing with their update.
      */
-    void switch_updated_list(const std::lock_guard<std::recursive_mutex> & guard);
+    void switch_updated_list(
+      const std::lock_guard<std::recursive_mutex> & guard,
+      const std::vector<std::string> & stopped_controllers = {});
 
     // Mutex protecting the controllers list
     // must be acquired before using any list other than the "used by rt"
@@ -320,14 +503,28 @@ private:
      */
     int get_other_list(int index) const;
 
-    void wait_until_rt_not_using(
-      int index, std::chrono::microseconds sleep_delay = std::chrono::microseconds(200)) const;
+    void wait_until_rt_not_using(int index);
+
+    /// update_active_list Caches the active controllers of the list with the given index
+    /**
+     * \param[in] group split the active controllers into groups of dependent controllers, which
+     * allocates, otherwise all active controllers are in one group.
+     * \param[in] stopped_controllers active controllers which are left out.
+     */
+    void update_active_list(
+      int index, bool group, const std::vector<std::string> & stopped_controllers);
 
     std::vector<ControllerSpec> controllers_lists_[2];
+    /// Copies of the active controllers of each list, independent of changes to the lists
+    std::vector<ControllerSpec> active_controllers_lists_[2];
+    /// Offsets of the groups of active controllers of each list
+    std::vector<size_t> active_controller_groups_[2];
     /// The index of the controller list with the most updated information
-    int updated_controllers_index_ = 0;
+    std::atomic<int> updated_controllers_index_{0};
     /// The index of the controllers list being used in the real-time thread.
-    int used_by_realtime_controllers_index_ = -1;
+    std::atomic<int> used_by_realtime_controllers_index_{-1};
+    /// Notifies threads waiting in wait_until_rt_not_using()
+    RealtimeNotifier rt_list_notifier_;
   };
 
   RTControllerListWrapper rt_controllers_wrapper_;
@@ -339,6 +536,8 @@ private:
   rclcpp::Service<controller_manager_msgs::srv::ListControllerTypes>::SharedPtr
     list_controller_types_service_;
   rclcpp::Service<controller_manager_msgs::srv::LoadController>::SharedPtr load_controller_service_;
+  rclcpp::Service<controller_manager_msgs::srv::LoadControllers>::SharedPtr
+    load_controllers_service_;
   rclcpp::Service<controller_manager_msgs::srv::ConfigureController>::SharedPtr
     configure_controller_service_;
   rclcpp::Service<controller_manager_msgs::srv::LoadConfigureController>::SharedPtr
@@ -351,6 +550,8 @@ private:
     reload_controller_libraries_service_;
   rclcpp::Service<controller_manager_msgs::srv::SwitchController>::SharedPtr
     switch_controller_service_;
+  rclcpp::Service<controller_manager_msgs::srv::SetActiveControllers>::SharedPtr
+    set_active_controllers_service_;
   rclcpp::Service<controller_manager_msgs::srv::UnloadController>::SharedPtr
     unload_controller_service_;
 
@@ -361,12 +562,39 @@ private:
   rclcpp::Service<controller_manager_msgs::srv::SetHardwareComponentState>::SharedPtr
     set_hardware_component_state_service_;
 
+  /// Execution time histograms of the phases of the real-time update loop
+  LatencyHistogram read_statistics_;
+  LatencyHistogram update_statistics_;
+  LatencyHistogram write_statistics_;
+  rclcpp::Publisher<controller_manager_msgs::msg::CycleStatistics>::SharedPtr
+    cycle_statistics_publisher_;
+  rclcpp::TimerBase::SharedPtr cycle_statistics_timer_;
+  std::unique_ptr<LoopScheduler> loop_scheduler_;
+
+  /// Polls the resource manager for failed hardware components, not created if no error policy
+  /// needs to stop controllers
+  rclcpp::TimerBase::SharedPtr hardware_error_timer_;
+
+  /// Recorder of the interface values of every cycle, nullptr if recording is disabled
+  std::unique_ptr<InterfaceRecorder> interface_recorder_;
+  /// Start and execution times of the phases of the current cycle, only used by the update loop
+  std::chrono::nanoseconds cycle_start_time_{0};
+  std::chrono::nanoseconds read_time_{0};
+  std::chrono::nanoseconds update_time_{0};
+
+  /// Workers updating independent controllers in parallel, nullptr to update them serially
+  std::unique_ptr<WorkerPool> worker_pool_;
+
   std::vector<std::string> start_request_, stop_request_;
   std::vector<std::string> start_command_interface_request_, stop_command_interface_request_;
 
   struct SwitchParams
   {
-    bool do_switch = {false};
+    /// Set by the non-RT thread after all other fields, reset by the RT thread after the switch
+    std::atomic_bool do_switch = {false};
+    /// Index of the controllers list with the started controllers, the RT thread commits the
+    /// switch in the first cycle using it
+    int controllers_list = {-1};
     bool started = {false};
     rclcpp::Time init_time = {rclcpp::Time::max()};
 
@@ -374,9 +602,27 @@ private:
     int strictness = {0};
     bool start_asap = {false};
     rclcpp::Duration timeout = rclcpp::Duration{0, 0};
+
+    /// A started controller which waits for the mode switch of its command interfaces
+    struct PendingStart
+    {
+      std::string name;
+      std::vector<std::string> command_interfaces;
+      std::shared_ptr<std::atomic_bool> waiting;
+    };
+    /// Filled by start_controllers() before do_switch is set
+    std::vector<PendingStart> pending_starts;
+    /// Set by the RT thread with the commit, reset by it when no started controller waits anymore
+    std::atomic_bool check_pending_starts = {false};
+    /// Set by the non-RT thread after the timeout, the RT thread then stops checking
+    std::atomic_bool abort_pending_starts = {false};
+    /// Set by the RT thread with the commit if the hardware failed to perform the mode switch
+    std::atomic_bool mode_switch_failed = {false};
   };
 
   SwitchParams switch_params_;
+  /// Notifies switch_controller() that the RT thread finished the switch
+  RealtimeNotifier switch_done_notifier_;
 };
 
 }  // namespace controller_manager
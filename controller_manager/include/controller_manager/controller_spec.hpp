@@ -19,24 +19,74 @@
 #ifndef CONTROLLER_MANAGER__CONTROLLER_SPEC_HPP_
 #define CONTROLLER_MANAGER__CONTROLLER_SPEC_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include "controller_interface/controller_interface.hpp"
+#include "controller_manager/controller_update_scheduler.hpp"
 #include "hardware_interface/controller_info.hpp"
 
 namespace controller_manager
 {
+/// Execution time statistics of the update method of a controller
+/**
+ * The statistics are written by the real-time loop and read by the services of the controller
+ * manager. They are therefore lock-free and shared between all copies of a controller spec.
+ */
+struct ControllerUpdateStatistics
+{
+  /// Record the execution time of one update. Real-time safe.
+  void record(std::chrono::nanoseconds execution_time)
+  {
+    const int64_t value = execution_time.count();
+    last_ns.store(value, std::memory_order_relaxed);
+    sum_ns.fetch_add(value, std::memory_order_relaxed);
+    update_count.fetch_add(1, std::memory_order_relaxed);
+    int64_t current_max = max_ns.load(std::memory_order_relaxed);
+    while (value > current_max &&
+           !max_ns.compare_exchange_weak(current_max, value, std::memory_order_relaxed))
+    {
+    }
+    if (budget.count() > 0 && execution_time > budget)
+    {
+      overrun_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /// Execution time budget of one update, zero if not limited.
+  std::chrono::nanoseconds budget{0};
+
+  std::atomic<int64_t> last_ns{0};
+  std::atomic<int64_t> max_ns{0};
+  std::atomic<int64_t> sum_ns{0};
+  std::atomic<uint64_t> update_count{0};
+  /// Number of updates which took longer than the budget
+  std::atomic<uint64_t> overrun_count{0};
+};
+
 /// Controller Specification
 /**
  * This struct contains both a pointer to a given controller, \ref c, as well
- * as information about the controller, \ref info.
+ * as information about the controller, \ref info, the execution time statistics
+ * of its update method, \ref update_statistics, and the schedule of its updates,
+ * \ref update_scheduler.
  *
  */
 struct ControllerSpec
 {
   hardware_interface::ControllerInfo info;
   controller_interface::ControllerInterfaceSharedPtr c;
+  std::shared_ptr<ControllerUpdateStatistics> update_statistics;
+  /// Shared between all copies of the spec, only used by the real-time thread
+  std::shared_ptr<ControllerUpdateScheduler> update_scheduler;
+  /// Set while the controller is active but the hardware did not complete the mode switch of its
+  /// command interfaces yet, the real-time thread does not update it meanwhile. Shared between
+  /// all copies of the spec.
+  std::shared_ptr<std::atomic_bool> waiting_for_mode_switch;
 };
 
 }  // namespace controller_manager
@@ -0,0 +1,66 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROLLER_MANAGER__CONTROLLER_UPDATE_SCHEDULER_HPP_
+#define CONTROLLER_MANAGER__CONTROLLER_UPDATE_SCHEDULER_HPP_
+
+#include <chrono>
+
+#include "controller_manager/visibility_control.h"
+
+namespace controller_manager
+{
+/// Decides in which cycles of the update loop a controller is updated.
+/**
+ * A controller with a lower update rate than the update loop is updated in the cycle closest to
+ * each of its deadlines. The deadlines are a fixed grid with the period of the controller, so the
+ * average update rate is exact even if it does not divide the rate of the update loop.
+ * The controller gets the time actually elapsed since its previous update as period.
+ *
+ * Only used by the real-time thread, all methods are real-time safe.
+ */
+class ControllerUpdateScheduler
+{
+public:
+  /// Restart the schedule, e.g., when the controller is activated.
+  /**
+   * \param[in] controller_period period of the controller, zero to update it in every cycle.
+   * \param[in] first_update time from now until the first update of the controller, used to
+   * stagger the updates of controllers with the same rate over different cycles.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  void reset(std::chrono::nanoseconds controller_period, std::chrono::nanoseconds first_update);
+
+  /// Advance the schedule by one cycle of the update loop.
+  /**
+   * \param[in] cycle_period time elapsed since the previous cycle.
+   * \param[in] loop_period nominal period of the update loop.
+   * \param[out] elapsed time elapsed since the previous update of the controller, only set if
+   * the controller is due in this cycle.
+   * \return true if the controller is due in this cycle.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  bool advance(
+    std::chrono::nanoseconds cycle_period, std::chrono::nanoseconds loop_period,
+    std::chrono::nanoseconds & elapsed);
+
+private:
+  std::chrono::nanoseconds controller_period_{0};
+  std::chrono::nanoseconds time_to_next_update_{0};
+  std::chrono::nanoseconds elapsed_since_last_update_{0};
+};
+
+}  // namespace controller_manager
+
+#endif  // CONTROLLER_MANAGER__CONTROLLER_UPDATE_SCHEDULER_HPP_
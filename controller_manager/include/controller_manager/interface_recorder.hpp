@@ -0,0 +1,157 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROLLER_MANAGER__INTERFACE_RECORDER_HPP_
+#define CONTROLLER_MANAGER__INTERFACE_RECORDER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "controller_manager/visibility_control.h"
+#include "hardware_interface/state_snapshot.hpp"
+
+namespace controller_manager
+{
+/// Recorder of the interface values and execution times of every cycle of the update loop.
+/**
+ * The records are written to a ring in a memory-mapped file, which is allocated and touched when
+ * the file is opened, so recording only copies the values once, from the value arena of the
+ * resource manager into mapped pages. The file should be on a RAM
+ * backed file system, e.g., /dev/shm, so writing back the pages never stalls the update loop.
+ * The `recording_to_csv` script of this package converts a file to CSV.
+ *
+ * Each record is the row of one cycle, so a cycle writes a single contiguous block, and the
+ * script transposes the rows to columns offline. A record only holds the values of the
+ * interfaces, without the padding between the values of the components in the value arena.
+ *
+ * File format, all numbers in the byte order of the recording machine:
+ * - header: FileHeader, followed by `interface_count` interface descriptions, each consisting of
+ *   InterfaceHeader and `name_length` characters of the full interface name; padded to
+ *   `records_offset`.
+ * - `capacity` records of `record_size` bytes: RecordHeader followed by `value_count` values
+ *   laid out as described by the interfaces. Record number n is stored at n % capacity.
+ *
+ * \note Only the update loop is allowed to call commit().
+ */
+class InterfaceRecorder
+{
+public:
+  static constexpr char kMagic[8] = {'R', 'O', 'S', '2', 'C', 'R', 'E', 'C'};
+  static constexpr uint32_t kFormatVersion = 2;
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t interface_count;
+    uint64_t records_offset;
+    uint64_t record_size;
+    uint64_t capacity;
+    uint64_t value_count;
+    /// Number of records written so far, updated after each record is complete
+    uint64_t record_count;
+  };
+
+  struct InterfaceHeader
+  {
+    /// Index of the first value of the interface in the values of a record
+    uint64_t index;
+    /// Number of values, larger than one for array interfaces
+    uint32_t size;
+    /// hardware_interface::HandleDataType, whose bytes are stored at the start of each value
+    uint8_t data_type;
+    /// 1 for command interfaces, 0 for state interfaces
+    uint8_t is_command;
+    uint16_t name_length;
+  };
+
+  struct RecordHeader
+  {
+    /// Time stamp of the monotonic clock in nanoseconds at the start of the cycle
+    int64_t stamp;
+    /// Execution times of the phases of the cycle in nanoseconds
+    int64_t read_time;
+    int64_t update_time;
+    int64_t write_time;
+  };
+
+  CONTROLLER_MANAGER_PUBLIC
+  InterfaceRecorder() = default;
+
+  CONTROLLER_MANAGER_PUBLIC
+  ~InterfaceRecorder();
+
+  InterfaceRecorder(const InterfaceRecorder &) = delete;
+  InterfaceRecorder & operator=(const InterfaceRecorder &) = delete;
+
+  /// Create the file at \p path and map a ring of \p capacity records into memory.
+  /**
+   * Not real-time safe.
+   *
+   * \param[in] layout where the values of the interfaces are in the values passed to commit().
+   * \param[in] value_count number of values passed to commit(), including values which are not
+   * part of any interface. Interfaces beyond them are not recorded.
+   * \return false if the file could not be created or mapped, with errno set to the reason.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  bool open(
+    const std::string & path, const hardware_interface::StateSnapshotLayout & layout,
+    size_t value_count, size_t capacity);
+
+  CONTROLLER_MANAGER_PUBLIC
+  bool is_open() const;
+
+  /// Write the next record with the time stamp, the execution times of the cycle and the values
+  /// of the interfaces.
+  /**
+   * Real-time safe, copies the values of the interfaces directly into the record.
+   *
+   * \param[in] values at least the number of values passed to open(), laid out as described by
+   * the layout passed to open().
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  void commit(
+    const double * values, std::chrono::nanoseconds stamp, std::chrono::nanoseconds read_time,
+    std::chrono::nanoseconds update_time, std::chrono::nanoseconds write_time);
+
+  /// Number of records written so far.
+  CONTROLLER_MANAGER_PUBLIC
+  uint64_t get_record_count() const;
+
+private:
+  /// Values of interfaces which are contiguous in the values passed to the recorder
+  struct ValueRun
+  {
+    size_t index;
+    size_t count;
+  };
+
+  void close();
+
+  /// Runs of the values passed to commit(), copied to the record without the padding between them
+  std::vector<ValueRun> runs_;
+
+  unsigned char * mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  int fd_ = -1;
+  FileHeader * header_ = nullptr;
+  unsigned char * records_ = nullptr;
+};
+
+}  // namespace controller_manager
+
+#endif  // CONTROLLER_MANAGER__INTERFACE_RECORDER_HPP_
@@ -0,0 +1,93 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROLLER_MANAGER__LATENCY_HISTOGRAM_HPP_
+#define CONTROLLER_MANAGER__LATENCY_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "controller_manager/visibility_control.h"
+
+namespace controller_manager
+{
+/// Statistics of the latencies recorded in a LatencyHistogram.
+struct LatencyStatistics
+{
+  uint64_t sample_count = 0;
+  std::chrono::nanoseconds min{0};
+  std::chrono::nanoseconds max{0};
+  std::chrono::nanoseconds mean{0};
+  std::chrono::nanoseconds p99{0};
+  std::chrono::nanoseconds p999{0};
+};
+
+/// Lock-free histogram of latencies, filled by the real-time loop and drained by a non-RT thread.
+/**
+ * The histogram uses logarithmic buckets which are linearly subdivided, so the relative error of
+ * the reported percentiles is bounded by 1/kSubBuckets independent of the magnitude of the value.
+ * Recording a sample neither allocates nor locks, all buckets are preallocated atomics.
+ */
+class LatencyHistogram
+{
+public:
+  /// Number of linear sub-buckets in each power of two.
+  static constexpr size_t kSubBucketBits = 4;
+  static constexpr size_t kSubBuckets = 1u << kSubBucketBits;
+  /// Latencies of 2^(kMaxExponent + 1) ns (about 36 minutes) or longer share the last bucket.
+  static constexpr size_t kMaxExponent = 40;
+  static constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+  CONTROLLER_MANAGER_PUBLIC
+  LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram & operator=(const LatencyHistogram &) = delete;
+
+  /// Record a latency sample. Real-time safe.
+  CONTROLLER_MANAGER_PUBLIC
+  void record(std::chrono::nanoseconds latency);
+
+  /// Compute the statistics of all samples since the last call and reset the histogram.
+  /**
+   * Samples recorded concurrently to this call are attributed either to this or to the next
+   * drain, but never lost.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  LatencyStatistics drain();
+
+  CONTROLLER_MANAGER_PUBLIC
+  static size_t bucket_index(uint64_t value);
+
+  /// Smallest value counted in the bucket with the given index.
+  CONTROLLER_MANAGER_PUBLIC
+  static uint64_t bucket_lower_bound(size_t index);
+
+  /// Number of values counted in the bucket with the given index.
+  CONTROLLER_MANAGER_PUBLIC
+  static uint64_t bucket_width(size_t index);
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace controller_manager
+
+#endif  // CONTROLLER_MANAGER__LATENCY_HISTOGRAM_HPP_
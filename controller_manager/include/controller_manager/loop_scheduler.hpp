@@ -0,0 +1,90 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROLLER_MANAGER__LOOP_SCHEDULER_HPP_
+#define CONTROLLER_MANAGER__LOOP_SCHEDULER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "controller_manager/visibility_control.h"
+#include "hardware_interface/thread_configuration.hpp"
+
+namespace controller_manager
+{
+/// Scheduler for the periodic real-time control loop.
+/**
+ * The scheduler sleeps until absolute deadlines on the monotonic clock, so the loop period does
+ * not drift with the execution time of each cycle or with the wake-up latency of the sleep.
+ *
+ * A deadline is missed when a cycle finishes after the next deadline has already passed.
+ * In that case the scheduler does not try to catch up by running several cycles back to back,
+ * instead it skips to the next deadline on the same time grid and counts all skipped deadlines
+ * as overruns.
+ *
+ * \note Only the loop thread is allowed to call start() and sleep_until_next_period(), the
+ * overrun statistics can be read from any thread.
+ */
+class LoopScheduler
+{
+public:
+  CONTROLLER_MANAGER_PUBLIC
+  explicit LoopScheduler(std::chrono::nanoseconds period);
+
+  /// Set the first deadline one period after the current time.
+  CONTROLLER_MANAGER_PUBLIC
+  void start();
+
+  /// Sleep until the next deadline of the loop.
+  /**
+   * \return true if the deadline was met, false if one or more deadlines were missed.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  bool sleep_until_next_period();
+
+  CONTROLLER_MANAGER_PUBLIC
+  std::chrono::nanoseconds get_period() const;
+
+  /// Number of deadlines missed since start().
+  CONTROLLER_MANAGER_PUBLIC
+  uint64_t get_overrun_count() const;
+
+  /// How late the loop was at the last missed deadline.
+  CONTROLLER_MANAGER_PUBLIC
+  std::chrono::nanoseconds get_last_overrun() const;
+
+private:
+  const std::chrono::nanoseconds period_;
+  /// Next deadline in nanoseconds of the monotonic clock
+  std::chrono::nanoseconds next_deadline_;
+
+  std::atomic<uint64_t> overrun_count_;
+  std::atomic<int64_t> last_overrun_ns_;
+};
+
+// shared with the threads of the hardware components
+using hardware_interface::configure_sched_fifo;
+using hardware_interface::set_thread_affinity;
+
+/// Lock all current and future pages of the process into RAM to avoid page faults.
+/**
+ * \return true on success, false otherwise with errno set to the reason of the failure.
+ */
+CONTROLLER_MANAGER_PUBLIC
+bool lock_memory();
+
+}  // namespace controller_manager
+
+#endif  // CONTROLLER_MANAGER__LOOP_SCHEDULER_HPP_
@@ -0,0 +1,77 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROLLER_MANAGER__REALTIME_NOTIFIER_HPP_
+#define CONTROLLER_MANAGER__REALTIME_NOTIFIER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace controller_manager
+{
+/// Wakes up non-RT threads waiting for a condition which is changed by the real-time thread.
+/**
+ * The condition itself has to be expressed with atomics. The real-time thread changes it and
+ * calls notify(), which never blocks: the mutex of the condition variable is only tried, and if
+ * a waiter holds it while checking the condition, the notification may be missed. Waiters
+ * therefore re-check the condition at least every \ref kMaxWaitPeriod.
+ */
+class RealtimeNotifier
+{
+public:
+  /// Upper bound of the time a waiter sleeps without re-checking its condition.
+  static constexpr std::chrono::milliseconds kMaxWaitPeriod{10};
+
+  /// Wake up all waiting threads. Real-time safe, never blocks.
+  void notify()
+  {
+    if (waiters_.load() == 0)
+    {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    condition_.notify_all();
+  }
+
+  /// Block until \p condition is true or \p abort is true.
+  /**
+   * \return the last result of \p condition, i.e., false if waiting was aborted.
+   */
+  template <typename Condition, typename Abort>
+  bool wait(Condition condition, Abort abort)
+  {
+    waiters_.fetch_add(1);
+    bool result = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!(result = condition()) && !abort())
+      {
+        condition_.wait_for(lock, kMaxWaitPeriod);
+      }
+    }
+    waiters_.fetch_sub(1);
+    return result;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::atomic<int> waiters_{0};
+};
+
+}  // namespace controller_manager
+
+#endif  // CONTROLLER_MANAGER__REALTIME_NOTIFIER_HPP_
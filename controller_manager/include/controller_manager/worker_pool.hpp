@@ -0,0 +1,111 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROLLER_MANAGER__WORKER_POOL_HPP_
+#define CONTROLLER_MANAGER__WORKER_POOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "controller_manager/visibility_control.h"
+
+namespace controller_manager
+{
+/// Pool of pre-spawned threads executing the tasks of a cycle of the real-time loop in parallel.
+/**
+ * The calling thread takes part in executing the tasks, and run() returns only after all workers
+ * finished, i.e., it acts as a barrier. Running tasks neither allocates nor creates threads.
+ *
+ * Runs are handed over through atomics without taking any lock. A thread waiting for the next
+ * run or for the workers spins for a bounded number of iterations and then blocks on a futex,
+ * so a real-time caller does not starve workers of lower priority sharing its CPU.
+ */
+class WorkerPool
+{
+public:
+  /// Spawn the worker threads.
+  /**
+   * \param[in] thread_count number of worker threads in addition to the calling thread.
+   * \param[in] cpus CPUs the workers are pinned to, one CPU per worker in round-robin order.
+   * Workers are not pinned if empty.
+   * \param[in] priority SCHED_FIFO priority of the workers, 0 to keep the default policy.
+   */
+  CONTROLLER_MANAGER_PUBLIC
+  explicit WorkerPool(size_t thread_count, const std::vector<int> & cpus = {}, int priority = 0);
+
+  CONTROLLER_MANAGER_PUBLIC
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  CONTROLLER_MANAGER_PUBLIC
+  size_t get_thread_count() const;
+
+  /// False if pinning or setting the scheduling policy of a worker failed.
+  CONTROLLER_MANAGER_PUBLIC
+  bool is_configured() const;
+
+  /// Call function(index) for each index in [0, task_count) and wait until all calls finished.
+  /**
+   * The tasks are distributed dynamically over the workers and the calling thread.
+   * Only one thread at a time is allowed to call run().
+   */
+  template <typename Function>
+  void run(size_t task_count, Function & function)
+  {
+    run_tasks(task_count, &function, [](void * f, size_t index) {
+      (*static_cast<Function *>(f))(index);
+    });
+  }
+
+private:
+  using Invoker = void (*)(void *, size_t);
+
+  CONTROLLER_MANAGER_PUBLIC
+  void run_tasks(size_t task_count, void * function, Invoker invoke);
+
+  void work(size_t worker_index, const std::vector<int> & cpus, int priority);
+
+  void execute_tasks();
+
+  /// Wait until all workers finished the current run.
+  void wait_for_workers();
+
+  std::vector<std::thread> threads_;
+
+  /// Incremented for each run and on stop, workers wait for it to change
+  std::atomic<uint32_t> generation_{0};
+  std::atomic_bool stop_{false};
+  /// Number of workers blocked waiting for the next run
+  std::atomic<uint32_t> sleeping_workers_{0};
+  /// Whether the thread calling run() is blocked waiting for the workers
+  std::atomic_bool caller_sleeping_{false};
+
+  // tasks of the current run
+  void * function_ = nullptr;
+  Invoker invoke_ = nullptr;
+  size_t task_count_ = 0;
+  std::atomic<size_t> next_task_{0};
+  /// Number of workers which finished the current run or finished starting up
+  std::atomic<uint32_t> finished_workers_{0};
+  std::atomic_bool configured_{true};
+};
+
+}  // namespace controller_manager
+
+#endif  // CONTROLLER_MANAGER__WORKER_POOL_HPP_
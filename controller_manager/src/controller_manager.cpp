@@ -14,9 +14,17 @@
 
 #include "controller_manager/controller_manager.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <list>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -33,6 +41,9 @@ namespace
 static constexpr const char * kControllerInterfaceName = "controller_interface";
 static constexpr const char * kControllerInterface = "controller_interface::ControllerInterface";
 
+/// Period in which failed hardware components are handled outside of the update loop
+static constexpr std::chrono::milliseconds kHardwareErrorCheckPeriod{10};
+
 // Changed services history QoS to keep all so we don't lose any client service calls
 static const rmw_qos_profile_t rmw_qos_profile_services_hist_keep_all = {
   RMW_QOS_POLICY_HISTORY_KEEP_ALL,
@@ -72,6 +83,109 @@ bool controller_name_compare(const controller_manager::ControllerSpec & a, const
   return a.info.name == name;
 }
 
+/// Sort the controllers into groups of controllers which depend on each other
+/**
+ * Two controllers depend on each other if one of them claims a command interface which the other
+ * one claims as command or state interface, or if one of them claims all interfaces of a type.
+ * Dependent controllers end up in the same group, keeping their relative order.
+ * \param[in,out] controllers controllers to sort.
+ * \param[out] group_offsets group i consists of controllers [group_offsets[i], group_offsets[i + 1]).
+ */
+void group_dependent_controllers(
+  std::vector<controller_manager::ControllerSpec *> & controllers,
+  std::vector<size_t> & group_offsets)
+{
+  const size_t count = controllers.size();
+  std::vector<bool> claims_all(count, false);
+  std::vector<std::vector<std::string>> command_interfaces(count);
+  std::vector<std::vector<std::string>> all_interfaces(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto command_config = controllers[i]->c->command_interface_configuration();
+    const auto state_config = controllers[i]->c->state_interface_configuration();
+    if (
+      command_config.type == controller_interface::interface_configuration_type::ALL ||
+      state_config.type == controller_interface::interface_configuration_type::ALL)
+    {
+      claims_all[i] = true;
+      continue;
+    }
+    command_interfaces[i] = command_config.names;
+    std::sort(command_interfaces[i].begin(), command_interfaces[i].end());
+    all_interfaces[i] = command_config.names;
+    all_interfaces[i].insert(
+      all_interfaces[i].end(), state_config.names.begin(), state_config.names.end());
+    std::sort(all_interfaces[i].begin(), all_interfaces[i].end());
+  }
+
+  const auto intersects = [](const std::vector<std::string> & a, const std::vector<std::string> & b) {
+    for (auto it_a = a.begin(), it_b = b.begin(); it_a != a.end() && it_b != b.end();)
+    {
+      if (*it_a < *it_b)
+      {
+        ++it_a;
+      }
+      else if (*it_b < *it_a)
+      {
+        ++it_b;
+      }
+      else
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // union-find of the dependent controllers
+  std::vector<size_t> parent(count);
+  std::iota(parent.begin(), parent.end(), 0);
+  const auto find = [&parent](size_t i) {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = i + 1; j < count; ++j)
+    {
+      if (
+        claims_all[i] || claims_all[j] || intersects(command_interfaces[i], all_interfaces[j]) ||
+        intersects(command_interfaces[j], all_interfaces[i]))
+      {
+        parent[find(j)] = find(i);
+      }
+    }
+  }
+
+  std::vector<controller_manager::ControllerSpec *> grouped;
+  grouped.reserve(count);
+  std::vector<bool> assigned(count, false);
+  group_offsets.clear();
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (assigned[i])
+    {
+      continue;
+    }
+    group_offsets.push_back(grouped.size());
+    const size_t group = find(i);
+    for (size_t j = i; j < count; ++j)
+    {
+      if (!assigned[j] && find(j) == group)
+      {
+        grouped.push_back(controllers[j]);
+        assigned[j] = true;
+      }
+    }
+  }
+  group_offsets.push_back(count);
+  std::copy(grouped.begin(), grouped.end(), controllers.begin());
+}
+
 }  // namespace
 
 namespace controller_manager
@@ -109,6 +223,11 @@ ControllerManager::ControllerManager(
   init_resource_manager(robot_description);
 
   init_services();
+  init_cycle_statistics();
+  init_worker_pool();
+  init_hardware_read_write();
+  init_interface_recorder();
+  init_hardware_error_handling();
 }
 
 ControllerManager::ControllerManager(
@@ -122,6 +241,11 @@ ControllerManager::ControllerManager(
     kControllerInterfaceName, kControllerInterface))
 {
   init_services();
+  init_cycle_statistics();
+  init_worker_pool();
+  init_hardware_read_write();
+  init_interface_recorder();
+  init_hardware_error_handling();
 }
 
 void ControllerManager::init_resource_manager(const std::string & robot_description)
@@ -177,6 +301,9 @@ void ControllerManager::init_services()
   load_controller_service_ = create_service<controller_manager_msgs::srv::LoadController>(
     "~/load_controller", std::bind(&ControllerManager::load_controller_service_cb, this, _1, _2),
     rmw_qos_profile_services_hist_keep_all, best_effort_callback_group_);
+  load_controllers_service_ = create_service<controller_manager_msgs::srv::LoadControllers>(
+    "~/load_controllers", std::bind(&ControllerManager::load_controllers_service_cb, this, _1, _2),
+    rmw_qos_profile_services_hist_keep_all, best_effort_callback_group_);
   configure_controller_service_ = create_service<controller_manager_msgs::srv::ConfigureController>(
     "~/configure_controller",
     std::bind(&ControllerManager::configure_controller_service_cb, this, _1, _2),
@@ -205,6 +332,11 @@ void ControllerManager::init_services()
     "~/switch_controller",
     std::bind(&ControllerManager::switch_controller_service_cb, this, _1, _2),
     rmw_qos_profile_services_hist_keep_all, best_effort_callback_group_);
+  set_active_controllers_service_ =
+    create_service<controller_manager_msgs::srv::SetActiveControllers>(
+      "~/set_active_controllers",
+      std::bind(&ControllerManager::set_active_controllers_service_cb, this, _1, _2),
+      rmw_qos_profile_services_hist_keep_all, best_effort_callback_group_);
   unload_controller_service_ = create_service<controller_manager_msgs::srv::UnloadController>(
     "~/unload_controller",
     std::bind(&ControllerManager::unload_controller_service_cb, this, _1, _2),
@@ -226,23 +358,280 @@ void ControllerManager::init_services()
       rmw_qos_profile_services_hist_keep_all, best_effort_callback_group_);
 }
 
+void ControllerManager::init_cycle_statistics()
+{
+  // Use nanoseconds to avoid chrono's rounding
+  loop_scheduler_ = std::make_unique<LoopScheduler>(
+    std::chrono::nanoseconds(std::chrono::seconds(1)) / std::max(update_rate_, 1u));
+
+  double publish_period = 1.0;
+  get_parameter("cycle_statistics_publish_period", publish_period);
+  if (publish_period <= 0.0)
+  {
+    RCLCPP_INFO(get_logger(), "Publishing of cycle statistics is disabled.");
+    return;
+  }
+
+  cycle_statistics_publisher_ =
+    create_publisher<controller_manager_msgs::msg::CycleStatistics>("~/cycle_statistics", 10);
+  cycle_statistics_timer_ = create_wall_timer(
+    std::chrono::duration<double>(publish_period),
+    std::bind(&ControllerManager::publish_cycle_statistics, this), best_effort_callback_group_);
+}
+
+void ControllerManager::init_worker_pool()
+{
+  int update_threads = 0;
+  get_parameter("update_threads", update_threads);
+  if (update_threads <= 0)
+  {
+    return;
+  }
+
+  std::vector<int64_t> cpu_affinity;
+  get_parameter("update_threads_cpu_affinity", cpu_affinity);
+  int thread_priority = 0;
+  get_parameter("update_threads_priority", thread_priority);
+
+  worker_pool_ = std::make_unique<WorkerPool>(
+    static_cast<size_t>(update_threads), std::vector<int>(cpu_affinity.begin(), cpu_affinity.end()),
+    thread_priority);
+  if (!worker_pool_->is_configured())
+  {
+    RCLCPP_WARN(
+      get_logger(), "Could not pin the update threads or set their scheduling policy as requested.");
+  }
+  rt_controllers_wrapper_.group_active_controllers = true;
+  RCLCPP_INFO(
+    get_logger(), "Updating independent controllers in parallel on %d additional thread(s).",
+    update_threads);
+}
+
+void ControllerManager::init_hardware_read_write()
+{
+  double timeout = 0.0;
+  get_parameter("hardware_read_write_timeout", timeout);
+  if (timeout > 0.0)
+  {
+    resource_manager_->set_read_write_timeout(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(timeout)));
+  }
+
+  bool parallel_read_write = false;
+  get_parameter("parallel_hardware_read_write", parallel_read_write);
+  if (!parallel_read_write)
+  {
+    return;
+  }
+
+  std::vector<int64_t> cpu_affinity;
+  get_parameter("hardware_threads_cpu_affinity", cpu_affinity);
+  int thread_priority = 0;
+  get_parameter("hardware_threads_priority", thread_priority);
+
+  if (!resource_manager_->enable_parallel_read_write(
+        std::vector<int>(cpu_affinity.begin(), cpu_affinity.end()), thread_priority))
+  {
+    RCLCPP_WARN(
+      get_logger(),
+      "Could not pin the hardware threads or set their scheduling policy as requested.");
+  }
+  RCLCPP_INFO(get_logger(), "Reading and writing hardware components in parallel.");
+}
+
+void ControllerManager::init_interface_recorder()
+{
+  std::string path;
+  get_parameter("interface_recorder_path", path);
+  if (path.empty())
+  {
+    return;
+  }
+  int capacity = 10000;
+  get_parameter("interface_recorder_capacity", capacity);
+  capacity = std::max(capacity, 1);
+
+  auto recorder = std::make_unique<InterfaceRecorder>();
+  if (!recorder->open(
+        path, resource_manager_->get_interface_value_layout(),
+        resource_manager_->get_interface_value_count(), static_cast<size_t>(capacity)))
+  {
+    RCLCPP_ERROR(
+      get_logger(), "Could not create the interface recording '%s': %s", path.c_str(),
+      std::strerror(errno));
+    return;
+  }
+  interface_recorder_ = std::move(recorder);
+  RCLCPP_INFO(
+    get_logger(), "Recording the interface values of the last %d cycles to '%s'.", capacity,
+    path.c_str());
+}
+
+void ControllerManager::init_hardware_error_handling()
+{
+  bool stops_controllers = false;
+  for (const auto & [component_name, component_info] : resource_manager_->get_components_status())
+  {
+    const std::string prefix = "hardware_error_handling." + component_name + ".";
+    std::string action_name;
+    if (!get_parameter(prefix + "action", action_name))
+    {
+      continue;
+    }
+    hardware_interface::HardwareErrorPolicy policy;
+    if (!hardware_interface::from_string(action_name, policy.action))
+    {
+      RCLCPP_ERROR(
+        get_logger(), "Unknown error action '%s' of hardware component '%s', keeping '%s'.",
+        action_name.c_str(), component_name.c_str(),
+        hardware_interface::to_string(component_info.error_policy.action).c_str());
+      continue;
+    }
+    int error_threshold = 1;
+    get_parameter(prefix + "error_threshold", error_threshold);
+    policy.error_threshold = static_cast<unsigned int>(std::max(error_threshold, 1));
+    int skip_cycles = 100;
+    get_parameter(prefix + "skip_cycles", skip_cycles);
+    policy.skip_cycles = static_cast<unsigned int>(std::max(skip_cycles, 0));
+    get_parameter(prefix + "timeouts_fail_cycle", policy.timeouts_fail_cycle);
+    resource_manager_->set_error_policy(component_name, policy);
+
+    stops_controllers = stops_controllers ||
+                        policy.action == hardware_interface::HardwareErrorAction::DEACTIVATE ||
+                        policy.action == hardware_interface::HardwareErrorAction::STOP_CONTROLLERS;
+  }
+
+  if (stops_controllers)
+  {
+    hardware_error_timer_ = create_wall_timer(
+      kHardwareErrorCheckPeriod, std::bind(&ControllerManager::handle_hardware_errors, this),
+      best_effort_callback_group_);
+  }
+}
+
+void ControllerManager::handle_hardware_errors()
+{
+  const auto failed_components = resource_manager_->take_failed_components();
+  if (failed_components.empty())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> services_guard(services_lock_);
+  auto components = resource_manager_->get_components_status();
+  for (const auto & component_name : failed_components)
+  {
+    const auto & component = components[component_name];
+    const bool deactivate =
+      component.error_policy.action == hardware_interface::HardwareErrorAction::DEACTIVATE;
+    RCLCPP_ERROR(
+      get_logger(), "Hardware component '%s' failed in %u consecutive cycles, %s.",
+      component_name.c_str(), component.error_policy.error_threshold,
+      deactivate ? "deactivating it and the controllers using it"
+                 : "stopping the controllers using it");
+
+    const auto uses_component = [](
+                                  const controller_interface::InterfaceConfiguration & config,
+                                  const std::vector<std::string> & component_interfaces) {
+      if (config.type == controller_interface::interface_configuration_type::ALL)
+      {
+        return !component_interfaces.empty();
+      }
+      return std::any_of(
+        config.names.begin(), config.names.end(), [&component_interfaces](const auto & name) {
+          return std::find(component_interfaces.begin(), component_interfaces.end(), name) !=
+                 component_interfaces.end();
+        });
+    };
+    std::vector<std::string> stop_controllers;
+    {
+      std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+      for (const auto & controller : rt_controllers_wrapper_.get_updated_list(guard))
+      {
+        if (
+          is_controller_active(controller.c) &&
+          (uses_component(
+             controller.c->command_interface_configuration(), component.command_interfaces) ||
+           uses_component(
+             controller.c->state_interface_configuration(), component.state_interfaces)))
+        {
+          stop_controllers.push_back(controller.info.name);
+        }
+      }
+    }
+    if (
+      !stop_controllers.empty() &&
+      switch_controller(
+        {}, stop_controllers,
+        controller_manager_msgs::srv::SwitchController::Request::BEST_EFFORT) !=
+        controller_interface::return_type::OK)
+    {
+      RCLCPP_ERROR(
+        get_logger(), "Could not stop the controllers using hardware component '%s'.",
+        component_name.c_str());
+    }
+
+    if (deactivate)
+    {
+      rclcpp_lifecycle::State inactive_state(
+        lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE,
+        hardware_interface::lifecycle_state_names::INACTIVE);
+      if (
+        resource_manager_->set_component_state(component_name, inactive_state) !=
+        hardware_interface::return_type::OK)
+      {
+        RCLCPP_ERROR(
+          get_logger(), "Could not deactivate hardware component '%s'.", component_name.c_str());
+      }
+    }
+  }
+}
+
+void ControllerManager::publish_cycle_statistics()
+{
+  const auto to_msg = [](const std::string & name, const LatencyStatistics & statistics) {
+    controller_manager_msgs::msg::LatencyStatistics msg;
+    msg.name = name;
+    msg.sample_count = statistics.sample_count;
+    msg.min = std::chrono::duration<double>(statistics.min).count();
+    msg.max = std::chrono::duration<double>(statistics.max).count();
+    msg.mean = std::chrono::duration<double>(statistics.mean).count();
+    msg.p99 = std::chrono::duration<double>(statistics.p99).count();
+    msg.p999 = std::chrono::duration<double>(statistics.p999).count();
+    return msg;
+  };
+
+  controller_manager_msgs::msg::CycleStatistics msg;
+  msg.stamp = now();
+  msg.phases.reserve(3);
+  msg.phases.push_back(to_msg("read", read_statistics_.drain()));
+  msg.phases.push_back(to_msg("update", update_statistics_.drain()));
+  msg.phases.push_back(to_msg("write", write_statistics_.drain()));
+  msg.missed_deadlines = loop_scheduler_->get_overrun_count();
+  msg.last_overrun = std::chrono::duration<double>(loop_scheduler_->get_last_overrun()).count();
+  cycle_statistics_publisher_->publish(msg);
+}
+
 controller_interface::ControllerInterfaceSharedPtr ControllerManager::load_controller(
   const std::string & controller_name, const std::string & controller_type)
 {
   RCLCPP_INFO(get_logger(), "Loading controller '%s'", controller_name.c_str());
 
-  if (!loader_->isClassAvailable(controller_type))
+  controller_interface::ControllerInterfaceSharedPtr controller;
   {
-    RCLCPP_ERROR(get_logger(), "Loader for controller '%s' not found.", controller_name.c_str());
-    RCLCPP_INFO(get_logger(), "Available classes:");
-    for (const auto & available_class : loader_->getDeclaredClasses())
+    std::lock_guard<std::mutex> guard(loader_mutex_);
+    if (!loader_->isClassAvailable(controller_type))
     {
-      RCLCPP_INFO(get_logger(), "  %s", available_class.c_str());
+      RCLCPP_ERROR(get_logger(), "Loader for controller '%s' not found.", controller_name.c_str());
+      RCLCPP_INFO(get_logger(), "Available classes:");
+      for (const auto & available_class : loader_->getDeclaredClasses())
+      {
+        RCLCPP_INFO(get_logger(), "  %s", available_class.c_str());
+      }
+      return nullptr;
     }
-    return nullptr;
+    controller = loader_->createSharedInstance(controller_type);
   }
-
-  auto controller = loader_->createSharedInstance(controller_type);
   ControllerSpec controller_spec;
   controller_spec.c = controller;
   controller_spec.info.name = controller_name;
@@ -276,6 +665,46 @@ controller_interface::ControllerInterfaceSharedPtr ControllerManager::load_contr
   return load_controller(controller_name, controller_type);
 }
 
+std::vector<controller_interface::ControllerInterfaceSharedPtr>
+ControllerManager::load_controllers(const std::vector<std::string> & controller_names)
+{
+  std::vector<controller_interface::ControllerInterfaceSharedPtr> controllers(
+    controller_names.size());
+  const size_t thread_count = std::min<size_t>(
+    controller_names.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+  // each thread loads the next controller which was not taken yet
+  std::atomic<size_t> next_controller{0};
+  const auto load_next_controllers = [this, &controller_names, &controllers, &next_controller]() {
+    for (size_t i = next_controller++; i < controller_names.size(); i = next_controller++)
+    {
+      try
+      {
+        controllers[i] = load_controller(controller_names[i]);
+      }
+      catch (const std::exception & e)
+      {
+        RCLCPP_ERROR(
+          get_logger(), "Caught exception while loading controller '%s': %s",
+          controller_names[i].c_str(), e.what());
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (size_t i = 1; i < thread_count; ++i)
+  {
+    threads.emplace_back(load_next_controllers);
+  }
+  load_next_controllers();
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  return controllers;
+}
+
 controller_interface::return_type ControllerManager::unload_controller(
   const std::string & controller_name)
 {
@@ -398,7 +827,16 @@ controller_interface::return_type ControllerManager::switch_controller(
   const std::vector<std::string> & stop_controllers, int strictness, bool start_asap,
   const rclcpp::Duration & timeout)
 {
-  switch_params_ = SwitchParams();
+  switch_params_.do_switch = false;
+  switch_params_.started = false;
+  switch_params_.init_time = rclcpp::Time::max();
+  switch_params_.strictness = 0;
+  switch_params_.start_asap = false;
+  switch_params_.timeout = rclcpp::Duration{0, 0};
+  switch_params_.pending_starts.clear();
+  switch_params_.check_pending_starts = false;
+  switch_params_.abort_pending_starts = false;
+  switch_params_.mode_switch_failed = false;
 
   if (!stop_request_.empty() || !start_request_.empty())
   {
@@ -436,23 +874,25 @@ controller_interface::return_type ControllerManager::switch_controller(
     RCLCPP_DEBUG(get_logger(), "- Stopping controller '%s'", controller.c_str());
   }
 
-  const auto list_controllers = [this, strictness](
-                                  const std::vector<std::string> & controller_list,
-                                  std::vector<std::string> & request_list,
-                                  const std::string & action) {
+  // names of the loaded controllers, so looking up many requested controllers stays linear
+  std::unordered_set<std::string> loaded_controllers;
+  {
     // lock controllers
     std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+    for (const auto & controller : rt_controllers_wrapper_.get_updated_list(guard))
+    {
+      loaded_controllers.insert(controller.info.name);
+    }
+  }
 
+  const auto list_controllers = [this, strictness, &loaded_controllers](
+                                  const std::vector<std::string> & controller_list,
+                                  std::vector<std::string> & request_list,
+                                  const std::string & action) {
     // list all controllers to stop/start
     for (const auto & controller : controller_list)
     {
-      const auto & updated_controllers = rt_controllers_wrapper_.get_updated_list(guard);
-
-      auto found_it = std::find_if(
-        updated_controllers.begin(), updated_controllers.end(),
-        std::bind(controller_name_compare, std::placeholders::_1, controller));
-
-      if (found_it == updated_controllers.end())
+      if (loaded_controllers.count(controller) == 0)
       {
         if (strictness == controller_manager_msgs::srv::SwitchController::Request::STRICT)
         {
@@ -523,14 +963,12 @@ controller_interface::return_type ControllerManager::switch_controller(
 
   const std::vector<ControllerSpec> & controllers = rt_controllers_wrapper_.get_updated_list(guard);
 
+  const std::unordered_set<std::string> stop_set(stop_request_.begin(), stop_request_.end());
+  const std::unordered_set<std::string> start_set(start_request_.begin(), start_request_.end());
   for (const auto & controller : controllers)
   {
-    auto stop_list_it = std::find(stop_request_.begin(), stop_request_.end(), controller.info.name);
-    bool in_stop_list = stop_list_it != stop_request_.end();
-
-    auto start_list_it =
-      std::find(start_request_.begin(), start_request_.end(), controller.info.name);
-    bool in_start_list = start_list_it != start_request_.end();
+    bool in_stop_list = stop_set.count(controller.info.name) > 0;
+    bool in_start_list = start_set.count(controller.info.name) > 0;
 
     const bool is_active = is_controller_active(*controller.c);
     const bool is_inactive = is_controller_inactive(*controller.c);
@@ -559,7 +997,8 @@ controller_interface::return_type ControllerManager::switch_controller(
         return ret;
       }
       in_stop_list = false;
-      stop_request_.erase(stop_list_it);
+      stop_request_.erase(
+        std::find(stop_request_.begin(), stop_request_.end(), controller.info.name));
     }
 
     // check for doubled start
@@ -572,7 +1011,8 @@ controller_interface::return_type ControllerManager::switch_controller(
         return ret;
       }
       in_start_list = false;
-      start_request_.erase(start_list_it);
+      start_request_.erase(
+        std::find(start_request_.begin(), start_request_.end(), controller.info.name));
     }
 
     // check for illegal start of an unconfigured/finalized controller
@@ -586,7 +1026,8 @@ controller_interface::return_type ControllerManager::switch_controller(
         return ret;
       }
       in_start_list = false;
-      start_request_.erase(start_list_it);
+      start_request_.erase(
+        std::find(start_request_.begin(), start_request_.end(), controller.info.name));
     }
 
     if (in_start_list)
@@ -622,27 +1063,27 @@ controller_interface::return_type ControllerManager::switch_controller(
       return controller_interface::return_type::ERROR;
     }
   }
-  // start the atomic controller switching
   switch_params_.strictness = strictness;
   switch_params_.start_asap = start_asap;
   switch_params_.init_time = rclcpp::Clock().now();
   switch_params_.timeout = timeout;
-  switch_params_.do_switch = true;
 
-  // wait until switch is finished
-  RCLCPP_DEBUG(get_logger(), "Request atomic controller switch from realtime loop");
-  while (rclcpp::ok() && switch_params_.do_switch)
+  // the RT thread stops updating the controllers to stop, before they are deactivated
+  if (!stop_request_.empty())
   {
-    if (!rclcpp::ok())
-    {
-      return controller_interface::return_type::ERROR;
-    }
-    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    RCLCPP_DEBUG(get_logger(), "Realtime stops updating the controllers to stop");
+    rt_controllers_wrapper_.get_unused_list(guard) = controllers;
+    rt_controllers_wrapper_.switch_updated_list(guard, stop_request_);
   }
 
+  // lifecycle transitions and claiming interfaces are not real-time safe, they are done here
+  // while the RT thread updates none of the affected controllers
+  stop_controllers();
+  start_controllers();
+
   // copy the controllers spec from the used to the unused list
   std::vector<ControllerSpec> & to = rt_controllers_wrapper_.get_unused_list(guard);
-  to = controllers;
+  to = rt_controllers_wrapper_.get_updated_list(guard);
 
   // update the claimed interface controller info
   for (auto & controller : to)
@@ -666,11 +1107,74 @@ controller_interface::return_type ControllerManager::switch_controller(
       controller.info.claimed_interfaces.clear();
     }
   }
-  // switch lists
+
+  // the RT thread commits the switch in the first cycle which updates the started controllers
+  RCLCPP_DEBUG(get_logger(), "Request atomic controller switch from realtime loop");
+  switch_params_.controllers_list = rt_controllers_wrapper_.get_unused_list_index(guard);
+  switch_params_.do_switch = true;
   rt_controllers_wrapper_.switch_updated_list(guard);
+  if (!switch_done_notifier_.wait(
+        [this]() { return !switch_params_.do_switch; }, []() { return !rclcpp::ok(); }))
+  {
+    return controller_interface::return_type::ERROR;
+  }
   // clear unused list
   rt_controllers_wrapper_.get_unused_list(guard).clear();
 
+  // the RT thread starts updating the started controllers once the hardware completed the mode
+  // switch of their interfaces, the wait is always bounded since it holds controllers_lock_
+  std::vector<std::string> rolled_back;
+  if (switch_params_.mode_switch_failed)
+  {
+    // the RT thread did not start checking the pending starts
+    rolled_back = roll_back_pending_starts(
+      guard, "the hardware failed to perform the mode switch of its command interfaces");
+  }
+  else
+  {
+    auto timeout = switch_params_.timeout;
+    if (timeout.nanoseconds() <= kInfiniteTimeout)
+    {
+      double default_timeout = 5.0;
+      get_parameter("command_mode_switch_timeout", default_timeout);
+      timeout = rclcpp::Duration::from_seconds(default_timeout);
+    }
+    const auto deadline = switch_params_.init_time + timeout;
+    if (!switch_done_notifier_.wait(
+          [this]() { return !switch_params_.check_pending_starts; },
+          [&deadline]() { return !rclcpp::ok() || rclcpp::Clock().now() >= deadline; }))
+    {
+      if (!rclcpp::ok())
+      {
+        return controller_interface::return_type::ERROR;
+      }
+      switch_params_.abort_pending_starts = true;
+      if (!switch_done_notifier_.wait(
+            [this]() { return !switch_params_.check_pending_starts; },
+            []() { return !rclcpp::ok(); }))
+      {
+        return controller_interface::return_type::ERROR;
+      }
+      rolled_back = roll_back_pending_starts(
+        guard,
+        "the hardware did not complete the mode switch of its command interfaces within the "
+        "timeout");
+    }
+  }
+  // only the rolled back controllers are deactivated, the stopped controllers stay inactive
+  if (
+    !rolled_back.empty() &&
+    switch_params_.strictness == controller_manager_msgs::srv::SwitchController::Request::STRICT)
+  {
+    start_request_.clear();
+    stop_request_.clear();
+    start_command_interface_request_.clear();
+    stop_command_interface_request_.clear();
+    switch_params_.pending_starts.clear();
+    return controller_interface::return_type::ERROR;
+  }
+  switch_params_.pending_starts.clear();
+
   start_request_.clear();
   stop_request_.clear();
 
@@ -680,34 +1184,162 @@ controller_interface::return_type ControllerManager::switch_controller(
   return controller_interface::return_type::OK;
 }
 
-controller_interface::ControllerInterfaceSharedPtr ControllerManager::add_controller_impl(
-  const ControllerSpec & controller)
+controller_interface::return_type ControllerManager::set_active_controllers(
+  const std::vector<std::string> & active_controllers,
+  const std::vector<std::string> & inactive_controllers, bool exclusive, int strictness,
+  bool start_asap, const rclcpp::Duration & timeout,
+  std::vector<std::string> & started_controllers, std::vector<std::string> & stopped_controllers)
 {
-  // lock controllers
-  std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+  started_controllers.clear();
+  stopped_controllers.clear();
+  const bool strict =
+    strictness == controller_manager_msgs::srv::SwitchController::Request::STRICT;
+
+  const std::unordered_set<std::string> active_set(
+    active_controllers.begin(), active_controllers.end());
+  const std::unordered_set<std::string> inactive_set(
+    inactive_controllers.begin(), inactive_controllers.end());
+  for (const auto & controller : inactive_controllers)
+  {
+    if (active_set.count(controller))
+    {
+      RCLCPP_ERROR(
+        get_logger(), "Controller '%s' can't be both active and inactive", controller.c_str());
+      return controller_interface::return_type::ERROR;
+    }
+  }
 
-  std::vector<ControllerSpec> & to = rt_controllers_wrapper_.get_unused_list(guard);
-  const std::vector<ControllerSpec> & from = rt_controllers_wrapper_.get_updated_list(guard);
+  // difference between the target configuration and the current state
+  std::vector<std::string> unconfigured_controllers;
+  {
+    std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+    std::unordered_set<std::string> loaded_controllers;
+    for (const auto & controller : rt_controllers_wrapper_.get_updated_list(guard))
+    {
+      const auto & name = controller.info.name;
+      loaded_controllers.insert(name);
+      if (active_set.count(name))
+      {
+        if (
+          controller.c->get_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_UNCONFIGURED)
+        {
+          unconfigured_controllers.push_back(name);
+        }
+        if (!is_controller_active(*controller.c))
+        {
+          started_controllers.push_back(name);
+        }
+      }
+      else if (is_controller_active(*controller.c) && (exclusive || inactive_set.count(name)))
+      {
+        stopped_controllers.push_back(name);
+      }
+    }
+    for (const auto * controllers : {&active_controllers, &inactive_controllers})
+    {
+      for (const auto & controller : *controllers)
+      {
+        if (loaded_controllers.count(controller))
+        {
+          continue;
+        }
+        if (strict)
+        {
+          RCLCPP_ERROR(
+            get_logger(),
+            "Could not set state of controller with name '%s' because no controller with this "
+            "name exists",
+            controller.c_str());
+          started_controllers.clear();
+          stopped_controllers.clear();
+          return controller_interface::return_type::ERROR;
+        }
+        RCLCPP_WARN(
+          get_logger(),
+          "Could not set state of controller with name '%s' because no controller with this "
+          "name exists",
+          controller.c_str());
+      }
+    }
+  }
 
-  // Copy all controllers from the 'from' list to the 'to' list
-  to = from;
+  // configuring is not real-time critical, it is chained before the switch
+  for (const auto & controller : unconfigured_controllers)
+  {
+    if (configure_controller(controller) != controller_interface::return_type::OK)
+    {
+      if (strict)
+      {
+        started_controllers.clear();
+        stopped_controllers.clear();
+        return controller_interface::return_type::ERROR;
+      }
+      started_controllers.erase(
+        std::find(started_controllers.begin(), started_controllers.end(), controller));
+    }
+  }
+
+  if (started_controllers.empty() && stopped_controllers.empty())
+  {
+    RCLCPP_DEBUG(get_logger(), "All controllers are in their target state already");
+    return controller_interface::return_type::OK;
+  }
+
+  // one switch, i.e., one commit of the RT thread, for all controllers
+  const auto ret = switch_controller(
+    started_controllers, stopped_controllers, strictness, start_asap, timeout);
+
+  // with BEST_EFFORT some controllers may not have been switched
+  std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+  std::unordered_set<std::string> active_now;
+  for (const auto & controller : rt_controllers_wrapper_.get_updated_list(guard))
+  {
+    if (is_controller_active(*controller.c))
+    {
+      active_now.insert(controller.info.name);
+    }
+  }
+  started_controllers.erase(
+    std::remove_if(
+      started_controllers.begin(), started_controllers.end(),
+      [&active_now](const std::string & name) { return active_now.count(name) == 0; }),
+    started_controllers.end());
+  stopped_controllers.erase(
+    std::remove_if(
+      stopped_controllers.begin(), stopped_controllers.end(),
+      [&active_now](const std::string & name) { return active_now.count(name) > 0; }),
+    stopped_controllers.end());
+  return ret;
+}
+
+controller_interface::ControllerInterfaceSharedPtr ControllerManager::add_controller_impl(
+  const ControllerSpec & controller)
+{
+  const auto is_loaded = [this, &controller](
+                           const std::lock_guard<std::recursive_mutex> & guard) {
+    const std::vector<ControllerSpec> & loaded = rt_controllers_wrapper_.get_updated_list(guard);
+    return std::find_if(
+             loaded.begin(), loaded.end(),
+             std::bind(controller_name_compare, std::placeholders::_1, controller.info.name)) !=
+           loaded.end();
+  };
 
-  auto found_it = std::find_if(
-    to.begin(), to.end(),
-    std::bind(controller_name_compare, std::placeholders::_1, controller.info.name));
   // Checks that we're not duplicating controllers
-  if (found_it != to.end())
   {
-    to.clear();
-    RCLCPP_ERROR(
-      get_logger(), "A controller named '%s' was already loaded inside the controller manager",
-      controller.info.name.c_str());
-    return nullptr;
+    std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+    if (is_loaded(guard))
+    {
+      RCLCPP_ERROR(
+        get_logger(), "A controller named '%s' was already loaded inside the controller manager",
+        controller.info.name.c_str());
+      return nullptr;
+    }
   }
 
+  // the controller is initialized without holding the lock, so other controllers can be loaded
+  // and switched meanwhile
   if (controller.c->init(controller.info.name) == controller_interface::return_type::ERROR)
   {
-    to.clear();
     RCLCPP_ERROR(
       get_logger(), "Could not initialize the controller named '%s'", controller.info.name.c_str());
     return nullptr;
@@ -724,18 +1356,29 @@ controller_interface::ControllerInterfaceSharedPtr ControllerManager::add_contro
       controller.info.name.c_str());
     controller.c->get_node()->set_parameter(use_sim_time);
   }
-  executor_->add_node(controller.c->get_node()->get_node_base_interface());
-  to.emplace_back(controller);
+  // the update budget defaults to the period of the controller manager's update loop
+  double update_budget = 1.0 / update_rate_;
+  get_parameter(controller.info.name + ".update_budget", update_budget);
 
-  // Destroys the old controllers list when the realtime thread is finished with it.
-  RCLCPP_DEBUG(get_logger(), "Realtime switches over to new controller list");
-  rt_controllers_wrapper_.switch_updated_list(guard);
-  RCLCPP_DEBUG(get_logger(), "Destruct controller");
-  std::vector<ControllerSpec> & new_unused_list = rt_controllers_wrapper_.get_unused_list(guard);
-  new_unused_list.clear();
-  RCLCPP_DEBUG(get_logger(), "Destruct controller finished");
+  ControllerSpec spec = controller;
+  spec.update_statistics = std::make_shared<ControllerUpdateStatistics>();
+  spec.update_statistics->budget = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(update_budget));
+  spec.update_scheduler = std::make_shared<ControllerUpdateScheduler>();
+  spec.waiting_for_mode_switch = std::make_shared<std::atomic_bool>(false);
 
-  return to.back().c;
+  std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+  // a controller with the same name might have been loaded while this one was initialized
+  if (is_loaded(guard))
+  {
+    RCLCPP_ERROR(
+      get_logger(), "A controller named '%s' was already loaded inside the controller manager",
+      controller.info.name.c_str());
+    return nullptr;
+  }
+  executor_->add_node(controller.c->get_node()->get_node_base_interface());
+  // the new controller is inactive, so the RT thread does not need to switch lists
+  return rt_controllers_wrapper_.add_to_updated_list(guard, spec).c;
 }
 
 void ControllerManager::manage_switch()
@@ -745,26 +1388,23 @@ void ControllerManager::manage_switch()
         start_command_interface_request_, stop_command_interface_request_))
   {
     RCLCPP_ERROR(get_logger(), "Error while performing mode switch.");
+    // the started controllers are deactivated again instead of waiting for the mode switch
+    switch_params_.mode_switch_failed = true;
   }
 
-  stop_controllers();
-
-  // start controllers once the switch is fully complete
-  if (!switch_params_.start_asap)
-  {
-    start_controllers();
-  }
-  else
-  {
-    // start controllers as soon as their required joints are done switching
-    start_controllers_asap();
-  }
+  // the started controllers wait for the mode switch of their interfaces
+  switch_params_.check_pending_starts =
+    !switch_params_.mode_switch_failed && !switch_params_.pending_starts.empty();
+  // All controllers started, switching done
+  switch_params_.do_switch = false;
+  switch_done_notifier_.notify();
 }
 
 void ControllerManager::stop_controllers()
 {
-  std::vector<ControllerSpec> & rt_controller_list =
-    rt_controllers_wrapper_.update_and_get_used_by_rt_list();
+  std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+  const std::vector<ControllerSpec> & rt_controller_list =
+    rt_controllers_wrapper_.get_updated_list(guard);
   // stop controllers
   for (const auto & request : stop_request_)
   {
@@ -796,8 +1436,9 @@ void ControllerManager::stop_controllers()
 
 void ControllerManager::start_controllers()
 {
-  std::vector<ControllerSpec> & rt_controller_list =
-    rt_controllers_wrapper_.update_and_get_used_by_rt_list();
+  std::lock_guard<std::recursive_mutex> guard(rt_controllers_wrapper_.controllers_lock_);
+  const std::vector<ControllerSpec> & rt_controller_list =
+    rt_controllers_wrapper_.get_updated_list(guard);
   for (const auto & request : start_request_)
   {
     auto found_it = std::find_if(
@@ -813,7 +1454,6 @@ void ControllerManager::start_controllers()
     }
     auto controller = found_it->c;
 
-    bool assignment_successful = true;
     // assign command interfaces to the controller
     auto command_interface_config = controller->command_interface_configuration();
     // default to controller_interface::configuration_type::NONE
@@ -829,32 +1469,14 @@ void ControllerManager::start_controllers()
       command_interface_names = command_interface_config.names;
     }
     std::vector<hardware_interface::LoanedCommandInterface> command_loans;
-    command_loans.reserve(command_interface_names.size());
-    for (const auto & command_interface : command_interface_names)
+    try
     {
-      if (resource_manager_->command_interface_is_claimed(command_interface))
-      {
-        RCLCPP_ERROR(
-          get_logger(),
-          "Resource conflict for controller '%s'. Command interface '%s' is already claimed.",
-          request.c_str(), command_interface.c_str());
-        assignment_successful = false;
-        break;
-      }
-      try
-      {
-        command_loans.emplace_back(resource_manager_->claim_command_interface(command_interface));
-      }
-      catch (const std::exception & e)
-      {
-        RCLCPP_ERROR(get_logger(), "Can't activate controller '%s': %s", request.c_str(), e.what());
-        assignment_successful = false;
-        break;
-      }
+      command_loans = resource_manager_->claim_command_interfaces(command_interface_names);
     }
-    // something went wrong during command interfaces, go skip the controller
-    if (!assignment_successful)
+    catch (const std::exception & e)
     {
+      // something went wrong during command interfaces, go skip the controller
+      RCLCPP_ERROR(get_logger(), "Can't activate controller '%s': %s", request.c_str(), e.what());
       continue;
     }
 
@@ -872,26 +1494,25 @@ void ControllerManager::start_controllers()
       state_interface_names = state_interface_config.names;
     }
     std::vector<hardware_interface::LoanedStateInterface> state_loans;
-    state_loans.reserve(state_interface_names.size());
-    for (const auto & state_interface : state_interface_names)
+    try
     {
-      try
-      {
-        state_loans.emplace_back(resource_manager_->claim_state_interface(state_interface));
-      }
-      catch (const std::exception & e)
-      {
-        RCLCPP_ERROR(get_logger(), "Can't activate controller '%s': %s", request.c_str(), e.what());
-        assignment_successful = false;
-        break;
-      }
+      state_loans = resource_manager_->claim_state_interfaces(state_interface_names);
+    }
+    catch (const std::exception & e)
+    {
+      // something went wrong during state interfaces, go skip the controller
+      RCLCPP_ERROR(get_logger(), "Can't activate controller '%s': %s", request.c_str(), e.what());
+      continue;
+    }
+    try
+    {
+      controller->assign_interfaces(std::move(command_loans), std::move(state_loans));
     }
-    // something went wrong during state interfaces, go skip the controller
-    if (!assignment_successful)
+    catch (const std::exception & e)
     {
+      RCLCPP_ERROR(get_logger(), "Can't activate controller '%s': %s", request.c_str(), e.what());
       continue;
     }
-    controller->assign_interfaces(std::move(command_loans), std::move(state_loans));
 
     const auto new_state = controller->get_node()->activate();
     if (new_state.id() != lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
@@ -900,15 +1521,112 @@ void ControllerManager::start_controllers()
         get_logger(), "After activating, controller '%s' is in state '%s', expected Active",
         controller->get_node()->get_name(), new_state.label().c_str());
     }
+    else
+    {
+      // not updated before the hardware completed the mode switch of its interfaces
+      found_it->waiting_for_mode_switch->store(true);
+      switch_params_.pending_starts.push_back(
+        {request, command_interface_names, found_it->waiting_for_mode_switch});
+    }
+
+    // controllers with a lower update rate are first updated in one of the cycles of their
+    // period, so the updates of several such controllers are spread over different cycles
+    const auto controller_update_rate = controller->get_update_rate();
+    if (controller_update_rate == 0 || controller_update_rate >= update_rate_)
+    {
+      found_it->update_scheduler->reset(std::chrono::nanoseconds(0), std::chrono::nanoseconds(0));
+    }
+    else
+    {
+      const auto loop_period = std::chrono::nanoseconds(std::chrono::seconds(1)) / update_rate_;
+      const unsigned int phase = next_update_phase_++ % (update_rate_ / controller_update_rate);
+      found_it->update_scheduler->reset(
+        std::chrono::nanoseconds(std::chrono::seconds(1)) / controller_update_rate,
+        (phase + 1) * loop_period);
+    }
   }
-  // All controllers started, switching done
-  switch_params_.do_switch = false;
 }
 
 void ControllerManager::start_controllers_asap()
 {
-  //  https://github.com/ros-controls/ros2_control/issues/263
-  start_controllers();
+  if (switch_params_.abort_pending_starts)
+  {
+    switch_params_.check_pending_starts = false;
+    switch_done_notifier_.notify();
+    return;
+  }
+
+  bool all_started = true;
+  for (auto & pending_start : switch_params_.pending_starts)
+  {
+    if (!pending_start.waiting->load())
+    {
+      continue;
+    }
+    if (!resource_manager_->is_command_mode_switch_done(pending_start.command_interfaces))
+    {
+      all_started = false;
+    }
+    else if (switch_params_.start_asap)
+    {
+      pending_start.waiting->store(false);
+    }
+  }
+  if (!all_started)
+  {
+    return;
+  }
+  for (auto & pending_start : switch_params_.pending_starts)
+  {
+    pending_start.waiting->store(false);
+  }
+  switch_params_.check_pending_starts = false;
+  switch_done_notifier_.notify();
+}
+
+std::vector<std::string> ControllerManager::roll_back_pending_starts(
+  const std::lock_guard<std::recursive_mutex> & guard, const std::string & reason)
+{
+  std::vector<std::string> rolled_back;
+  for (const auto & pending_start : switch_params_.pending_starts)
+  {
+    if (pending_start.waiting->load())
+    {
+      RCLCPP_ERROR(
+        get_logger(), "Deactivating controller '%s', %s", pending_start.name.c_str(),
+        reason.c_str());
+      rolled_back.push_back(pending_start.name);
+    }
+  }
+  if (rolled_back.empty())
+  {
+    return rolled_back;
+  }
+
+  // the RT thread never updated the controllers, so they can be deactivated here
+  stop_request_ = rolled_back;
+  stop_controllers();
+
+  std::vector<ControllerSpec> & to = rt_controllers_wrapper_.get_unused_list(guard);
+  to = rt_controllers_wrapper_.get_updated_list(guard);
+  for (auto & controller : to)
+  {
+    if (
+      std::find(rolled_back.begin(), rolled_back.end(), controller.info.name) !=
+      rolled_back.end())
+    {
+      controller.info.claimed_interfaces.clear();
+    }
+  }
+  rt_controllers_wrapper_.switch_updated_list(guard);
+  rt_controllers_wrapper_.get_unused_list(guard).clear();
+
+  // no list used by the RT thread contains the controllers as active anymore
+  for (const auto & pending_start : switch_params_.pending_starts)
+  {
+    pending_start.waiting->store(false);
+  }
+  return rolled_back;
 }
 
 void ControllerManager::list_controllers_srv_cb(
@@ -933,6 +1651,19 @@ void ControllerManager::list_controllers_srv_cb(
     cs.claimed_interfaces = controllers[i].info.claimed_interfaces;
     cs.state = controllers[i].c->get_state().label();
 
+    const auto & update_statistics = *controllers[i].update_statistics;
+    const auto update_count = update_statistics.update_count.load(std::memory_order_relaxed);
+    cs.update_statistics.update_count = update_count;
+    cs.update_statistics.last = 1e-9 * update_statistics.last_ns.load(std::memory_order_relaxed);
+    cs.update_statistics.max = 1e-9 * update_statistics.max_ns.load(std::memory_order_relaxed);
+    cs.update_statistics.mean =
+      update_count > 0
+        ? 1e-9 * update_statistics.sum_ns.load(std::memory_order_relaxed) / update_count
+        : 0.0;
+    cs.update_statistics.budget = std::chrono::duration<double>(update_statistics.budget).count();
+    cs.update_statistics.overrun_count =
+      update_statistics.overrun_count.load(std::memory_order_relaxed);
+
     // Get information about interfaces if controller are in 'inactive' or 'active' state
     if (is_controller_active(controllers[i].c) || is_controller_inactive(controllers[i].c))
     {
@@ -974,7 +1705,11 @@ void ControllerManager::list_controller_types_srv_cb(
   std::lock_guard<std::mutex> guard(services_lock_);
   RCLCPP_DEBUG(get_logger(), "list types service locked");
 
-  auto cur_types = loader_->getDeclaredClasses();
+  std::vector<std::string> cur_types;
+  {
+    std::lock_guard<std::mutex> loader_guard(loader_mutex_);
+    cur_types = loader_->getDeclaredClasses();
+  }
   for (const auto & cur_type : cur_types)
   {
     response->types.push_back(cur_type);
@@ -1000,6 +1735,32 @@ void ControllerManager::load_controller_service_cb(
     get_logger(), "loading service finished for controller '%s' ", request->name.c_str());
 }
 
+void ControllerManager::load_controllers_service_cb(
+  const std::shared_ptr<controller_manager_msgs::srv::LoadControllers::Request> request,
+  std::shared_ptr<controller_manager_msgs::srv::LoadControllers::Response> response)
+{
+  // lock services
+  RCLCPP_DEBUG(get_logger(), "loading service called for %zu controllers", request->names.size());
+  std::lock_guard<std::mutex> guard(services_lock_);
+  RCLCPP_DEBUG(get_logger(), "loading service locked");
+
+  const auto controllers = load_controllers(request->names);
+  response->ok = true;
+  for (size_t i = 0; i < controllers.size(); ++i)
+  {
+    if (controllers[i])
+    {
+      response->loaded_controllers.push_back(request->names[i]);
+    }
+    else
+    {
+      response->ok = false;
+    }
+  }
+
+  RCLCPP_DEBUG(get_logger(), "loading service finished");
+}
+
 void ControllerManager::configure_controller_service_cb(
   const std::shared_ptr<controller_manager_msgs::srv::ConfigureController::Request> request,
   std::shared_ptr<controller_manager_msgs::srv::ConfigureController::Response> response)
@@ -1170,8 +1931,11 @@ void ControllerManager::reload_controller_libraries_service_cb(
   assert(loaded_controllers.empty());
 
   // Force a reload on all the PluginLoaders (internally, this recreates the plugin loaders)
-  loader_ = std::make_shared<pluginlib::ClassLoader<controller_interface::ControllerInterface>>(
-    kControllerInterfaceName, kControllerInterface);
+  {
+    std::lock_guard<std::mutex> loader_guard(loader_mutex_);
+    loader_ = std::make_shared<pluginlib::ClassLoader<controller_interface::ControllerInterface>>(
+      kControllerInterfaceName, kControllerInterface);
+  }
   RCLCPP_INFO(
     get_logger(), "Controller manager: reloaded controller libraries for '%s'",
     kControllerInterfaceName);
@@ -1197,6 +1961,24 @@ void ControllerManager::switch_controller_service_cb(
   RCLCPP_DEBUG(get_logger(), "switching service finished");
 }
 
+void ControllerManager::set_active_controllers_service_cb(
+  const std::shared_ptr<controller_manager_msgs::srv::SetActiveControllers::Request> request,
+  std::shared_ptr<controller_manager_msgs::srv::SetActiveControllers::Response> response)
+{
+  // lock services
+  RCLCPP_DEBUG(get_logger(), "set active controllers service called");
+  std::lock_guard<std::mutex> guard(services_lock_);
+  RCLCPP_DEBUG(get_logger(), "set active controllers service locked");
+
+  response->ok = set_active_controllers(
+                   request->active_controllers, request->inactive_controllers,
+                   request->exclusive, request->strictness, request->start_asap,
+                   request->timeout, response->started_controllers,
+                   response->stopped_controllers) == controller_interface::return_type::OK;
+
+  RCLCPP_DEBUG(get_logger(), "set active controllers service finished");
+}
+
 void ControllerManager::unload_controller_service_cb(
   const std::shared_ptr<controller_manager_msgs::srv::UnloadController::Request> request,
   std::shared_ptr<controller_manager_msgs::srv::UnloadController::Response> response)
@@ -1234,6 +2016,25 @@ void ControllerManager::list_hardware_components_srv_cb(
     component.state.id = component_info.state.id();
     component.state.label = component_info.state.label();
 
+    auto fill_execution_statistics =
+      [](
+        const hardware_interface::HardwareComponentExecutionStatistics & statistics,
+        controller_manager_msgs::msg::HardwareComponentExecutionStatistics & msg) {
+        msg.count = statistics.count;
+        msg.last = std::chrono::duration<double>(statistics.last).count();
+        msg.mean = std::chrono::duration<double>(statistics.mean).count();
+        msg.max = std::chrono::duration<double>(statistics.max).count();
+        msg.timeout_count = statistics.timeout_count;
+        msg.error_count = statistics.error_count;
+      };
+    fill_execution_statistics(component_info.read_statistics, component.read_statistics);
+    fill_execution_statistics(component_info.write_statistics, component.write_statistics);
+    component.error_action = hardware_interface::to_string(component_info.error_policy.action);
+    component.error_threshold = component_info.error_policy.error_threshold;
+    component.timeouts_fail_cycle = component_info.error_policy.timeouts_fail_cycle;
+    component.skipped_cycles = component_info.skipped_cycles;
+    component.is_halted = component_info.is_halted;
+
     component.command_interfaces.reserve(component_info.command_interfaces.size());
     for (const auto & interface : component_info.command_interfaces)
     {
@@ -1337,64 +2138,180 @@ std::vector<std::string> ControllerManager::get_controller_names()
   return names;
 }
 
-void ControllerManager::read() { resource_manager_->read(); }
+void ControllerManager::read()
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  resource_manager_->read();
+  read_time_ = std::chrono::steady_clock::now() - start_time;
+  cycle_start_time_ = start_time.time_since_epoch();
+  read_statistics_.record(read_time_);
+}
 
 controller_interface::return_type ControllerManager::update(
   const rclcpp::Time & time, const rclcpp::Duration & period)
 {
-  std::vector<ControllerSpec> & rt_controller_list =
-    rt_controllers_wrapper_.update_and_get_used_by_rt_list();
-
-  auto ret = controller_interface::return_type::OK;
-  ++update_loop_counter_;
-  update_loop_counter_ %= update_rate_;
-
-  for (auto loaded_controller : rt_controller_list)
+  const auto start_time = std::chrono::steady_clock::now();
+  rt_controllers_wrapper_.update_and_get_used_by_rt_list();
+  // the prepared switch is committed before the started controllers are updated for the first time
+  if (
+    switch_params_.do_switch &&
+    rt_controllers_wrapper_.is_used_by_rt(switch_params_.controllers_list))
   {
-    // TODO(v-lopez) we could cache this information
-    // https://github.com/ros-controls/ros2_control/issues/153
-    if (is_controller_active(*loaded_controller.c))
-    {
-      const auto controller_update_rate = loaded_controller.c->get_update_rate();
+    manage_switch();
+  }
+  if (switch_params_.check_pending_starts)
+  {
+    start_controllers_asap();
+  }
 
-      bool controller_go =
-        controller_update_rate == 0 || ((update_loop_counter_ % controller_update_rate) == 0);
-      RCLCPP_DEBUG(
-        get_logger(), "update_loop_counter: '%d ' controller_go: '%s ' controller_name: '%s '",
-        update_loop_counter_, controller_go ? "True" : "False",
-        loaded_controller.info.name.c_str());
+  const auto loop_period = std::chrono::nanoseconds(std::chrono::seconds(1)) / update_rate_;
+  const auto cycle_period = std::chrono::nanoseconds(period.nanoseconds());
+  const auto & active_controllers = rt_controllers_wrapper_.get_active_rt_list();
+  const auto & groups = rt_controllers_wrapper_.get_active_rt_groups();
 
-      if (controller_go)
+  std::atomic_bool update_failed{false};
+  auto update_group = [&](size_t group) {
+    for (size_t i = groups[group]; i < groups[group + 1]; ++i)
+    {
+      const auto * loaded_controller = &active_controllers[i];
+      std::chrono::nanoseconds controller_period{0};
+      if (
+        loaded_controller->waiting_for_mode_switch->load() ||
+        !loaded_controller->update_scheduler->advance(cycle_period, loop_period, controller_period))
       {
-        auto controller_ret = loaded_controller.c->update(
-          time, (controller_update_rate != update_rate_ && controller_update_rate != 0)
-                  ? rclcpp::Duration::from_seconds(1.0 / controller_update_rate)
-                  : period);
+        continue;
+      }
+      const auto controller_start_time = std::chrono::steady_clock::now();
+      auto controller_ret = loaded_controller->c->update(
+        time, rclcpp::Duration::from_nanoseconds(controller_period.count()));
+      loaded_controller->update_statistics->record(
+        std::chrono::steady_clock::now() - controller_start_time);
 
-        if (controller_ret != controller_interface::return_type::OK)
-        {
-          ret = controller_ret;
-        }
+      if (controller_ret != controller_interface::return_type::OK)
+      {
+        update_failed = true;
       }
     }
+  };
+  const size_t group_count = groups.empty() ? 0 : groups.size() - 1;
+  if (worker_pool_)
+  {
+    // independent groups of controllers are updated concurrently, run() returns after all updates
+    worker_pool_->run(group_count, update_group);
   }
-
-  // there are controllers to start/stop
-  if (switch_params_.do_switch)
+  else
   {
-    manage_switch();
+    for (size_t group = 0; group < group_count; ++group)
+    {
+      update_group(group);
+    }
   }
+  auto ret = update_failed ? controller_interface::return_type::ERROR
+                           : controller_interface::return_type::OK;
 
+  update_time_ = std::chrono::steady_clock::now() - start_time;
+  update_statistics_.record(update_time_);
   return ret;
 }
 
-void ControllerManager::write() { resource_manager_->write(); }
+void ControllerManager::write()
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  resource_manager_->write();
+  const std::chrono::nanoseconds write_time = std::chrono::steady_clock::now() - start_time;
+  write_statistics_.record(write_time);
+
+  if (interface_recorder_)
+  {
+    interface_recorder_->commit(
+      resource_manager_->get_interface_values(), cycle_start_time_, read_time_, update_time_,
+      write_time);
+  }
+}
 
 std::vector<ControllerSpec> &
 ControllerManager::RTControllerListWrapper::update_and_get_used_by_rt_list()
 {
-  used_by_realtime_controllers_index_ = updated_controllers_index_;
-  return controllers_lists_[used_by_realtime_controllers_index_];
+  const int former_used_index = used_by_realtime_controllers_index_.load();
+  int index = updated_controllers_index_.load();
+  // Publish the index before using the list, and re-check it to not race with a concurrent
+  // switch_updated_list() which did not see the published index yet.
+  used_by_realtime_controllers_index_.store(index);
+  for (int updated_index = updated_controllers_index_.load(); index != updated_index;
+       updated_index = updated_controllers_index_.load())
+  {
+    index = updated_index;
+    used_by_realtime_controllers_index_.store(index);
+  }
+  if (index != former_used_index)
+  {
+    rt_list_notifier_.notify();
+  }
+  return controllers_lists_[index];
+}
+
+const std::vector<ControllerSpec> &
+ControllerManager::RTControllerListWrapper::get_active_rt_list() const
+{
+  return active_controllers_lists_[used_by_realtime_controllers_index_];
+}
+
+const std::vector<size_t> & ControllerManager::RTControllerListWrapper::get_active_rt_groups() const
+{
+  return active_controller_groups_[used_by_realtime_controllers_index_];
+}
+
+bool ControllerManager::RTControllerListWrapper::is_used_by_rt(int index) const
+{
+  return used_by_realtime_controllers_index_.load() == index;
+}
+
+void ControllerManager::RTControllerListWrapper::update_active_list(
+  int index, bool group, const std::vector<std::string> & stopped_controllers)
+{
+  std::vector<ControllerSpec *> active;
+  for (auto & controller : controllers_lists_[index])
+  {
+    if (
+      is_controller_active(*controller.c) &&
+      std::find(stopped_controllers.begin(), stopped_controllers.end(), controller.info.name) ==
+        stopped_controllers.end())
+    {
+      active.push_back(&controller);
+    }
+  }
+
+  auto & groups = active_controller_groups_[index];
+  if (group)
+  {
+    group_dependent_controllers(active, groups);
+  }
+  else
+  {
+    groups.clear();
+    groups.push_back(0);
+    groups.push_back(active.size());
+  }
+
+  auto & active_controllers = active_controllers_lists_[index];
+  active_controllers.clear();
+  for (const auto * controller : active)
+  {
+    active_controllers.push_back(*controller);
+  }
+}
+
+ControllerSpec & ControllerManager::RTControllerListWrapper::add_to_updated_list(
+  const std::lock_guard<std::recursive_mutex> &, const ControllerSpec & controller)
+{
+  if (!controllers_lock_.try_lock())
+  {
+    throw std::runtime_error("controllers_lock_ not owned by thread");
+  }
+  controllers_lock_.unlock();
+  auto & updated_list = controllers_lists_[updated_controllers_index_];
+  updated_list.push_back(controller);
+  return updated_list.back();
 }
 
 std::vector<ControllerSpec> & ControllerManager::RTControllerListWrapper::get_unused_list(
@@ -1413,6 +2330,12 @@ std::vector<ControllerSpec> & ControllerManager::RTControllerListWrapper::get_un
   return controllers_lists_[free_controllers_list];
 }
 
+int ControllerManager::RTControllerListWrapper::get_unused_list_index(
+  const std::lock_guard<std::recursive_mutex> &) const
+{
+  return get_other_list(updated_controllers_index_);
+}
+
 const std::vector<ControllerSpec> & ControllerManager::RTControllerListWrapper::get_updated_list(
   const std::lock_guard<std::recursive_mutex> &) const
 {
@@ -1425,7 +2348,8 @@ const std::vector<ControllerSpec> & ControllerManager::RTControllerListWrapper::
 }
 
 void ControllerManager::RTControllerListWrapper::switch_updated_list(
-  const std::lock_guard<std::recursive_mutex> &)
+  const std::lock_guard<std::recursive_mutex> &,
+  const std::vector<std::string> & stopped_controllers)
 {
   if (!controllers_lock_.try_lock())
   {
@@ -1433,8 +2357,16 @@ void ControllerManager::RTControllerListWrapper::switch_updated_list(
   }
   controllers_lock_.unlock();
   int former_current_controllers_list_ = updated_controllers_index_;
-  updated_controllers_index_ = get_other_list(former_current_controllers_list_);
+  // reserve space for all controllers, so the RT thread can update the cache without allocating
+  const int new_controllers_list = get_other_list(former_current_controllers_list_);
+  active_controllers_lists_[new_controllers_list].reserve(
+    controllers_lists_[new_controllers_list].size());
+  active_controller_groups_[new_controllers_list].reserve(2);
+  update_active_list(new_controllers_list, group_active_controllers, stopped_controllers);
+  updated_controllers_index_ = new_controllers_list;
   wait_until_rt_not_using(former_current_controllers_list_);
+  // release the copies of the controllers which are not used anymore
+  active_controllers_lists_[former_current_controllers_list_].clear();
 }
 
 int ControllerManager::RTControllerListWrapper::get_other_list(int index) const
@@ -1442,19 +2374,20 @@ int ControllerManager::RTControllerListWrapper::get_other_list(int index) const
   return (index + 1) % 2;
 }
 
-void ControllerManager::RTControllerListWrapper::wait_until_rt_not_using(
-  int index, std::chrono::microseconds sleep_period) const
+void ControllerManager::RTControllerListWrapper::wait_until_rt_not_using(int index)
 {
-  while (used_by_realtime_controllers_index_ == index)
+  if (!rt_list_notifier_.wait(
+        [this, index]() { return used_by_realtime_controllers_index_.load() != index; },
+        []() { return !rclcpp::ok(); }))
   {
-    if (!rclcpp::ok())
-    {
-      throw std::runtime_error("rclcpp interrupted");
-    }
-    std::this_thread::sleep_for(sleep_period);
+    throw std::runtime_error("rclcpp interrupted");
   }
 }
 
+bool ControllerManager::is_switch_pending() const { return switch_params_.do_switch.load(); }
+
 unsigned int ControllerManager::get_update_rate() const { return update_rate_; }
 
+LoopScheduler & ControllerManager::get_loop_scheduler() { return *loop_scheduler_; }
+
 }  // namespace controller_manager
@@ -0,0 +1,60 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "controller_manager/controller_update_scheduler.hpp"
+
+#include <chrono>
+
+namespace controller_manager
+{
+void ControllerUpdateScheduler::reset(
+  std::chrono::nanoseconds controller_period, std::chrono::nanoseconds first_update)
+{
+  controller_period_ = controller_period;
+  time_to_next_update_ = first_update;
+  elapsed_since_last_update_ = std::chrono::nanoseconds(0);
+}
+
+bool ControllerUpdateScheduler::advance(
+  std::chrono::nanoseconds cycle_period, std::chrono::nanoseconds loop_period,
+  std::chrono::nanoseconds & elapsed)
+{
+  elapsed_since_last_update_ += cycle_period;
+  if (controller_period_.count() <= 0)
+  {
+    elapsed = elapsed_since_last_update_;
+    elapsed_since_last_update_ = std::chrono::nanoseconds(0);
+    return true;
+  }
+
+  time_to_next_update_ -= cycle_period;
+  // a following cycle is closer to the deadline
+  if (2 * time_to_next_update_ >= loop_period)
+  {
+    return false;
+  }
+
+  elapsed = elapsed_since_last_update_;
+  elapsed_since_last_update_ = std::chrono::nanoseconds(0);
+  time_to_next_update_ += controller_period_;
+  if (2 * time_to_next_update_ < loop_period)
+  {
+    // skip updates missed, e.g., because of a stalled loop, but stay on the grid of deadlines
+    const auto missed_updates = (loop_period / 2 - time_to_next_update_) / controller_period_ + 1;
+    time_to_next_update_ += missed_updates * controller_period_;
+  }
+  return true;
+}
+
+}  // namespace controller_manager
@@ -0,0 +1,221 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "controller_manager/interface_recorder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{  // utility
+
+size_t align_up(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+namespace controller_manager
+{
+InterfaceRecorder::~InterfaceRecorder() { close(); }
+
+bool InterfaceRecorder::open(
+  const std::string & path, const hardware_interface::StateSnapshotLayout & layout,
+  size_t value_count, size_t capacity)
+{
+  close();
+  if (capacity == 0)
+  {
+    errno = EINVAL;
+    return false;
+  }
+#ifdef __linux__
+  struct Description
+  {
+    const hardware_interface::SnapshotInterfaceInfo * interface;
+    bool is_command;
+    /// Index of the first value of the interface in the records
+    size_t record_index;
+  };
+  std::vector<Description> descriptions;
+  size_t header_size = sizeof(FileHeader);
+  for (const auto * interfaces : {&layout.state_interfaces, &layout.command_interfaces})
+  {
+    for (const auto & interface : *interfaces)
+    {
+      if (interface.index + interface.size > value_count)
+      {
+        continue;
+      }
+      descriptions.push_back({&interface, interfaces == &layout.command_interfaces, 0});
+      header_size += sizeof(InterfaceHeader) + interface.name.size();
+    }
+  }
+
+  // the records keep the order of the values, but leave out the padding between them
+  std::vector<Description *> by_index;
+  for (auto & description : descriptions)
+  {
+    by_index.push_back(&description);
+  }
+  std::sort(
+    by_index.begin(), by_index.end(), [](const Description * a, const Description * b) {
+      return a->interface->index < b->interface->index;
+    });
+  runs_.clear();
+  size_t record_value_count = 0;
+  for (auto * description : by_index)
+  {
+    const auto & interface = *description->interface;
+    description->record_index = record_value_count;
+    record_value_count += interface.size;
+    if (!runs_.empty() && runs_.back().index + runs_.back().count == interface.index)
+    {
+      runs_.back().count += interface.size;
+    }
+    else
+    {
+      runs_.push_back({interface.index, interface.size});
+    }
+  }
+
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t records_offset = align_up(header_size, page_size);
+  const size_t record_size = sizeof(RecordHeader) + record_value_count * sizeof(double);
+  const size_t mapping_size = records_offset + capacity * record_size;
+
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0)
+  {
+    return false;
+  }
+  if (ftruncate(fd_, static_cast<off_t>(mapping_size)) != 0)
+  {
+    const int error = errno;
+    close();
+    errno = error;
+    return false;
+  }
+  void * mapping =
+    mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, 0);
+  if (mapping == MAP_FAILED)
+  {
+    const int error = errno;
+    close();
+    errno = error;
+    return false;
+  }
+  mapping_ = static_cast<unsigned char *>(mapping);
+  mapping_size_ = mapping_size;
+  // touch all pages, so recording does not page fault
+  std::memset(mapping_, 0, mapping_size_);
+
+  header_ = reinterpret_cast<FileHeader *>(mapping_);
+  std::memcpy(header_->magic, kMagic, sizeof(kMagic));
+  header_->format_version = kFormatVersion;
+  header_->interface_count = static_cast<uint32_t>(descriptions.size());
+  header_->records_offset = records_offset;
+  header_->record_size = record_size;
+  header_->capacity = capacity;
+  header_->value_count = record_value_count;
+  header_->record_count = 0;
+
+  unsigned char * position = mapping_ + sizeof(FileHeader);
+  for (const auto & description : descriptions)
+  {
+    InterfaceHeader interface_header;
+    interface_header.index = description.record_index;
+    interface_header.size = static_cast<uint32_t>(description.interface->size);
+    interface_header.data_type = static_cast<uint8_t>(description.interface->data_type);
+    interface_header.is_command = description.is_command ? 1 : 0;
+    interface_header.name_length = static_cast<uint16_t>(description.interface->name.size());
+    std::memcpy(position, &interface_header, sizeof(InterfaceHeader));
+    position += sizeof(InterfaceHeader);
+    std::memcpy(position, description.interface->name.data(), interface_header.name_length);
+    position += interface_header.name_length;
+  }
+  records_ = mapping_ + records_offset;
+  return true;
+#else
+  (void)path;
+  (void)layout;
+  (void)value_count;
+  (void)capacity;
+  errno = ENOTSUP;
+  return false;
+#endif
+}
+
+bool InterfaceRecorder::is_open() const { return header_ != nullptr && header_->capacity > 0; }
+
+void InterfaceRecorder::commit(
+  const double * values, std::chrono::nanoseconds stamp, std::chrono::nanoseconds read_time,
+  std::chrono::nanoseconds update_time, std::chrono::nanoseconds write_time)
+{
+  const uint64_t record_count = header_->record_count;
+  const uint64_t slot = record_count % header_->capacity;
+  RecordHeader record;
+  record.stamp = stamp.count();
+  record.read_time = read_time.count();
+  record.update_time = update_time.count();
+  record.write_time = write_time.count();
+  unsigned char * position = records_ + slot * header_->record_size;
+  std::memcpy(position, &record, sizeof(RecordHeader));
+  position += sizeof(RecordHeader);
+  for (const auto & run : runs_)
+  {
+    std::memcpy(position, values + run.index, run.count * sizeof(double));
+    position += run.count * sizeof(double);
+  }
+  // readers of the file see the record count only after the complete record
+  __atomic_store_n(&header_->record_count, record_count + 1, __ATOMIC_RELEASE);
+}
+
+uint64_t InterfaceRecorder::get_record_count() const
+{
+  return header_ ? __atomic_load_n(&header_->record_count, __ATOMIC_ACQUIRE) : 0;
+}
+
+void InterfaceRecorder::close()
+{
+#ifdef __linux__
+  if (mapping_)
+  {
+    munmap(mapping_, mapping_size_);
+  }
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+  }
+#endif
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  fd_ = -1;
+  header_ = nullptr;
+  records_ = nullptr;
+  runs_.clear();
+}
+
+}  // namespace controller_manager
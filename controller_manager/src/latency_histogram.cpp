@@ -0,0 +1,155 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "controller_manager/latency_histogram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace
+{  // utility
+
+/// Index of the most significant set bit, value has to be non-zero.
+inline size_t most_significant_bit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return 63u - static_cast<size_t>(__builtin_clzll(value));
+#else
+  size_t msb = 0;
+  while (value >>= 1)
+  {
+    ++msb;
+  }
+  return msb;
+#endif
+}
+
+}  // namespace
+
+namespace controller_manager
+{
+LatencyHistogram::LatencyHistogram()
+: sum_(0), min_(std::numeric_limits<uint64_t>::max()), max_(0)
+{
+  for (auto & bucket : buckets_)
+  {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency)
+{
+  const uint64_t value = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0u;
+
+  buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t current_min = min_.load(std::memory_order_relaxed);
+  while (value < current_min &&
+         !min_.compare_exchange_weak(current_min, value, std::memory_order_relaxed))
+  {
+  }
+  uint64_t current_max = max_.load(std::memory_order_relaxed);
+  while (value > current_max &&
+         !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+LatencyStatistics LatencyHistogram::drain()
+{
+  std::array<uint64_t, kBucketCount> counts;
+  uint64_t sample_count = 0;
+  for (size_t i = 0; i < kBucketCount; ++i)
+  {
+    counts[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+    sample_count += counts[i];
+  }
+  const uint64_t sum = sum_.exchange(0, std::memory_order_relaxed);
+  const uint64_t min = min_.exchange(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  const uint64_t max = max_.exchange(0, std::memory_order_relaxed);
+
+  LatencyStatistics statistics;
+  statistics.sample_count = sample_count;
+  if (sample_count == 0)
+  {
+    return statistics;
+  }
+  statistics.min = std::chrono::nanoseconds(std::min(min, max));
+  statistics.max = std::chrono::nanoseconds(max);
+  statistics.mean = std::chrono::nanoseconds(sum / sample_count);
+
+  const auto percentile = [&](double fraction) {
+    const auto rank =
+      std::max<uint64_t>(1u, static_cast<uint64_t>(std::ceil(fraction * sample_count)));
+    uint64_t cumulative_count = 0;
+    for (size_t i = 0; i < kBucketCount; ++i)
+    {
+      cumulative_count += counts[i];
+      if (cumulative_count >= rank)
+      {
+        // middle of the bucket, but never outside of the observed range
+        const uint64_t value = bucket_lower_bound(i) + bucket_width(i) / 2;
+        return std::chrono::nanoseconds(std::min(std::max(value, min), max));
+      }
+    }
+    return std::chrono::nanoseconds(max);
+  };
+  statistics.p99 = percentile(0.99);
+  statistics.p999 = percentile(0.999);
+
+  return statistics;
+}
+
+size_t LatencyHistogram::bucket_index(uint64_t value)
+{
+  if (value < kSubBuckets)
+  {
+    return static_cast<size_t>(value);
+  }
+  const size_t exponent = most_significant_bit(value);
+  if (exponent > kMaxExponent)
+  {
+    return kBucketCount - 1;
+  }
+  const size_t sub_bucket =
+    static_cast<size_t>(value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucket_lower_bound(size_t index)
+{
+  if (index < kSubBuckets)
+  {
+    return index;
+  }
+  const size_t exponent = index / kSubBuckets + kSubBucketBits - 1;
+  const uint64_t sub_bucket = index % kSubBuckets;
+  return (kSubBuckets + sub_bucket) << (exponent - kSubBucketBits);
+}
+
+uint64_t LatencyHistogram::bucket_width(size_t index)
+{
+  if (index < kSubBuckets)
+  {
+    return 1u;
+  }
+  const size_t exponent = index / kSubBuckets + kSubBucketBits - 1;
+  return uint64_t(1) << (exponent - kSubBucketBits);
+}
+
+}  // namespace controller_manager
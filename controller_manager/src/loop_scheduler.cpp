@@ -0,0 +1,121 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "controller_manager/loop_scheduler.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <time.h>
+#endif
+
+namespace
+{  // utility
+
+std::chrono::nanoseconds monotonic_now()
+{
+#ifdef __linux__
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch());
+#endif
+}
+
+void sleep_until(const std::chrono::nanoseconds & deadline)
+{
+#ifdef __linux__
+  timespec deadline_ts;
+  deadline_ts.tv_sec = static_cast<time_t>(deadline.count() / 1000000000);
+  deadline_ts.tv_nsec = static_cast<long>(deadline.count() % 1000000000);  // NOLINT
+  // clock_nanosleep returns the error directly and is restarted if interrupted by a signal
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline_ts, nullptr) == EINTR)
+  {
+  }
+#else
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(deadline));
+#endif
+}
+
+}  // namespace
+
+namespace controller_manager
+{
+LoopScheduler::LoopScheduler(std::chrono::nanoseconds period)
+: period_(period), next_deadline_(0), overrun_count_(0), last_overrun_ns_(0)
+{
+  if (period_.count() <= 0)
+  {
+    throw std::invalid_argument("The period of the control loop has to be positive.");
+  }
+}
+
+void LoopScheduler::start()
+{
+  next_deadline_ = monotonic_now();
+  overrun_count_ = 0;
+  last_overrun_ns_ = 0;
+}
+
+bool LoopScheduler::sleep_until_next_period()
+{
+  next_deadline_ += period_;
+
+  const auto now = monotonic_now();
+  bool deadline_met = true;
+  if (now > next_deadline_)
+  {
+    // skip all deadlines that already passed, but stay on the time grid of the loop
+    const auto lateness = now - next_deadline_;
+    const auto missed_deadlines = lateness / period_ + 1;
+    next_deadline_ += missed_deadlines * period_;
+
+    overrun_count_.fetch_add(static_cast<uint64_t>(missed_deadlines), std::memory_order_relaxed);
+    last_overrun_ns_.store(lateness.count(), std::memory_order_relaxed);
+    deadline_met = false;
+  }
+
+  sleep_until(next_deadline_);
+  return deadline_met;
+}
+
+std::chrono::nanoseconds LoopScheduler::get_period() const { return period_; }
+
+uint64_t LoopScheduler::get_overrun_count() const
+{
+  return overrun_count_.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LoopScheduler::get_last_overrun() const
+{
+  return std::chrono::nanoseconds(last_overrun_ns_.load(std::memory_order_relaxed));
+}
+
+bool lock_memory()
+{
+#ifdef __linux__
+  return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#else
+  errno = ENOTSUP;
+  return false;
+#endif
+}
+
+}  // namespace controller_manager
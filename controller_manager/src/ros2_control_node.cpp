@@ -13,12 +13,17 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cinttypes>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "controller_manager/controller_manager.hpp"
+#include "controller_manager/loop_scheduler.hpp"
 #include "rclcpp/rclcpp.hpp"
 
 using namespace std::chrono_literals;
@@ -40,18 +45,67 @@ int main(int argc, char ** argv)
   std::thread cm_thread([cm]() {
     RCLCPP_INFO(cm->get_logger(), "update rate is %d Hz", cm->get_update_rate());
 
+    int thread_priority = 0;
+    cm->get_parameter("thread_priority", thread_priority);
+    if (thread_priority > 0)
+    {
+      if (controller_manager::configure_sched_fifo(thread_priority))
+      {
+        RCLCPP_INFO(
+          cm->get_logger(), "Successfully set up FIFO RT scheduling policy with priority %d.",
+          thread_priority);
+      }
+      else
+      {
+        RCLCPP_WARN(
+          cm->get_logger(), "Could not enable FIFO RT scheduling policy with priority %d: %s",
+          thread_priority, strerror(errno));
+      }
+    }
+
+    std::vector<int64_t> cpu_affinity;
+    cm->get_parameter("cpu_affinity", cpu_affinity);
+    if (!cpu_affinity.empty())
+    {
+      if (controller_manager::set_thread_affinity(
+            std::vector<int>(cpu_affinity.begin(), cpu_affinity.end())))
+      {
+        RCLCPP_INFO(cm->get_logger(), "Pinned control loop to %zu CPU(s).", cpu_affinity.size());
+      }
+      else
+      {
+        RCLCPP_WARN(
+          cm->get_logger(), "Could not pin control loop to the requested CPUs: %s",
+          strerror(errno));
+      }
+    }
+
+    bool lock_memory = false;
+    cm->get_parameter("lock_memory", lock_memory);
+    if (lock_memory && !controller_manager::lock_memory())
+    {
+      RCLCPP_WARN(cm->get_logger(), "Could not lock memory: %s", strerror(errno));
+    }
+
+    // the controller manager publishes the missed deadlines with its cycle statistics
+    auto & scheduler = cm->get_loop_scheduler();
+    auto clock = cm->get_clock();
+
     rclcpp::Time current_time = cm->now();
     rclcpp::Time previous_time = current_time;
-    rclcpp::Time end_period = current_time;
-
-    // Use nanoseconds to avoid chrono's rounding
-    rclcpp::Duration period(std::chrono::nanoseconds(1000000000 / cm->get_update_rate()));
 
+    scheduler.start();
     while (rclcpp::ok())
     {
       // wait until we hit the end of the period
-      end_period += period;
-      std::this_thread::sleep_for(std::chrono::nanoseconds((end_period - cm->now()).nanoseconds()));
+      if (!scheduler.sleep_until_next_period())
+      {
+        RCLCPP_WARN_THROTTLE(
+          cm->get_logger(), *clock, 1000,
+          "Control loop missed its deadline by %.3f ms, %" PRIu64 " missed deadlines in total",
+          static_cast<double>(scheduler.get_last_overrun().count()) / 1e6,
+          scheduler.get_overrun_count());
+      }
 
       // execute "real-time" update loop
       cm->read();
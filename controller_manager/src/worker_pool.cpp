@@ -0,0 +1,168 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "controller_manager/worker_pool.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "controller_manager/loop_scheduler.hpp"
+#include "hardware_interface/futex.hpp"
+
+namespace controller_manager
+{
+using hardware_interface::cpu_relax;
+using hardware_interface::futex_wait;
+using hardware_interface::futex_wake_all;
+using hardware_interface::kSpinIterations;
+
+WorkerPool::WorkerPool(size_t thread_count, const std::vector<int> & cpus, int priority)
+{
+  threads_.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
+  {
+    threads_.emplace_back(&WorkerPool::work, this, i, cpus, priority);
+  }
+  // wait until all workers are configured
+  while (finished_workers_.load() < thread_count)
+  {
+    std::this_thread::yield();
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  stop_ = true;
+  generation_.fetch_add(1);
+  futex_wake_all(generation_);
+  for (auto & thread : threads_)
+  {
+    thread.join();
+  }
+}
+
+size_t WorkerPool::get_thread_count() const { return threads_.size(); }
+
+bool WorkerPool::is_configured() const { return configured_.load(); }
+
+void WorkerPool::run_tasks(size_t task_count, void * function, Invoker invoke)
+{
+  if (threads_.empty() || task_count <= 1)
+  {
+    for (size_t i = 0; i < task_count; ++i)
+    {
+      invoke(function, i);
+    }
+    return;
+  }
+
+  // the workers are all idle, they read the tasks only after the new generation was published
+  function_ = function;
+  invoke_ = invoke;
+  task_count_ = task_count;
+  next_task_.store(0);
+  finished_workers_.store(0);
+  generation_.fetch_add(1);
+  if (sleeping_workers_.load() > 0)
+  {
+    futex_wake_all(generation_);
+  }
+
+  execute_tasks();
+
+  // barrier, every worker takes part in every run, so no worker accesses the tasks afterwards
+  wait_for_workers();
+}
+
+void WorkerPool::wait_for_workers()
+{
+  const auto worker_count = static_cast<uint32_t>(threads_.size());
+  for (int i = 0; i < kSpinIterations; ++i)
+  {
+    if (finished_workers_.load() >= worker_count)
+    {
+      return;
+    }
+    cpu_relax();
+  }
+  while (true)
+  {
+    // a worker finishing after the flag is set sees it and wakes this thread up
+    caller_sleeping_.store(true);
+    const uint32_t finished = finished_workers_.load();
+    if (finished >= worker_count)
+    {
+      break;
+    }
+    futex_wait(finished_workers_, finished);
+  }
+  caller_sleeping_.store(false);
+}
+
+void WorkerPool::work(size_t worker_index, const std::vector<int> & cpus, int priority)
+{
+  if (!cpus.empty() && !set_thread_affinity({cpus[worker_index % cpus.size()]}))
+  {
+    configured_ = false;
+  }
+  if (priority > 0 && !configure_sched_fifo(priority))
+  {
+    configured_ = false;
+  }
+
+  uint32_t last_generation = generation_.load();
+  finished_workers_.fetch_add(1);
+  while (true)
+  {
+    for (int i = 0; i < kSpinIterations && generation_.load() == last_generation; ++i)
+    {
+      cpu_relax();
+    }
+    while (true)
+    {
+      // the caller sees the counter after publishing a run and wakes this worker up
+      sleeping_workers_.fetch_add(1);
+      const uint32_t generation = generation_.load();
+      if (generation != last_generation)
+      {
+        sleeping_workers_.fetch_sub(1);
+        last_generation = generation;
+        break;
+      }
+      futex_wait(generation_, generation);
+      sleeping_workers_.fetch_sub(1);
+    }
+    if (stop_)
+    {
+      return;
+    }
+    execute_tasks();
+    finished_workers_.fetch_add(1);
+    if (caller_sleeping_.load())
+    {
+      futex_wake_all(finished_workers_);
+    }
+  }
+}
+
+void WorkerPool::execute_tasks()
+{
+  for (size_t index = next_task_.fetch_add(1); index < task_count_;
+       index = next_task_.fetch_add(1))
+  {
+    invoke_(function_, index);
+  }
+}
+
+}  // namespace controller_manager
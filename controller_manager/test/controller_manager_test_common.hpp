@@ -19,6 +19,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
@@ -80,6 +81,34 @@ public:
     }
   }
 
+  /// Wait until the switch of \p switch_future is prepared, so the next update() commits it, or
+  /// until switch_controller() returned.
+  /**
+   * \param[in] update_while_waiting run update cycles while waiting, needed if controllers are
+   * stopped, which the update loop stops updating before they are deactivated. The last cycle
+   * may commit the switch then.
+   */
+  void wait_for_prepared_switch(
+    const std::future<controller_interface::return_type> & switch_future,
+    bool update_while_waiting = false)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (
+      !cm_->is_switch_pending() &&
+      switch_future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        ADD_FAILURE() << "switch_controller did not prepare the switch";
+        return;
+      }
+      if (update_while_waiting)
+      {
+        cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01));
+      }
+    }
+  }
+
   std::shared_ptr<rclcpp::Executor> executor_;
   std::shared_ptr<controller_manager::ControllerManager> cm_;
 
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
@@ -72,17 +74,20 @@ TEST_P(TestControllerManager, controller_lifecycle)
 
   EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, test_controller->get_state().id());
 
-  // Start controller, will take effect at the end of the update function
+  // Start controller, will take effect at the beginning of the update function
   std::vector<std::string> start_controllers = {"fake_controller", TEST_CONTROLLER2_NAME};
   std::vector<std::string> stop_controllers = {};
   auto switch_future = std::async(
     std::launch::async, &controller_manager::ControllerManager::switch_controller, cm_,
     start_controllers, stop_controllers, test_param.strictness, true, rclcpp::Duration(0, 0));
+  // a STRICT switch fails immediately, a BEST_EFFORT one waits for the next update cycle
+  wait_for_prepared_switch(switch_future);
 
   EXPECT_EQ(
     controller_interface::return_type::OK,
     cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)));
-  EXPECT_EQ(0u, test_controller2->internal_counter) << "Controller is started at the end of update";
+  EXPECT_EQ(test_param.expected_counter, test_controller2->internal_counter)
+    << "Controller is started at the beginning of update";
   {
     ControllerManagerRunner cm_runner(this);
     EXPECT_EQ(test_param.expected_return, switch_future.get());
@@ -93,7 +98,7 @@ TEST_P(TestControllerManager, controller_lifecycle)
     cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)));
   EXPECT_GE(test_controller2->internal_counter, test_param.expected_counter);
 
-  // Start the real test controller, will take effect at the end of the update function
+  // Start the real test controller, will take effect at the beginning of the update function
   start_controllers = {test_controller::TEST_CONTROLLER_NAME};
   stop_controllers = {};
   switch_future = std::async(
@@ -102,11 +107,13 @@ TEST_P(TestControllerManager, controller_lifecycle)
 
   ASSERT_EQ(std::future_status::timeout, switch_future.wait_for(std::chrono::milliseconds(100)))
     << "switch_controller should be blocking until next update cycle";
+  wait_for_prepared_switch(switch_future);
 
   EXPECT_EQ(
     controller_interface::return_type::OK,
     cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)));
-  EXPECT_EQ(0u, test_controller->internal_counter) << "Controller is started at the end of update";
+  EXPECT_EQ(1u, test_controller->internal_counter)
+    << "Controller is started at the beginning of update";
   {
     ControllerManagerRunner cm_runner(this);
     EXPECT_EQ(controller_interface::return_type::OK, switch_future.get());
@@ -119,7 +126,7 @@ TEST_P(TestControllerManager, controller_lifecycle)
   EXPECT_GE(test_controller->internal_counter, 1u);
   auto last_internal_counter = test_controller->internal_counter;
 
-  // Stop controller, will take effect at the end of the update function
+  // Stop controller, will take effect at the beginning of the update function
   start_controllers = {};
   stop_controllers = {test_controller::TEST_CONTROLLER_NAME};
   switch_future = std::async(
@@ -128,12 +135,15 @@ TEST_P(TestControllerManager, controller_lifecycle)
 
   ASSERT_EQ(std::future_status::timeout, switch_future.wait_for(std::chrono::milliseconds(100)))
     << "switch_controller should be blocking until next update cycle";
+  // the update loop stops updating the controller before the switch is prepared
+  wait_for_prepared_switch(switch_future, true);
+  last_internal_counter = test_controller->internal_counter;
 
   EXPECT_EQ(
     controller_interface::return_type::OK,
     cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)));
-  EXPECT_EQ(last_internal_counter + 1u, test_controller->internal_counter)
-    << "Controller is stopped at the end of update, so it should have done one more update";
+  EXPECT_EQ(last_internal_counter, test_controller->internal_counter)
+    << "Controller is stopped at the beginning of update, so it should have done no more update";
   {
     ControllerManagerRunner cm_runner(this);
     EXPECT_EQ(controller_interface::return_type::OK, switch_future.get());
@@ -183,7 +193,7 @@ TEST_P(TestControllerManager, per_controller_update_rate)
 
   EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, test_controller->get_state().id());
 
-  // Start controller, will take effect at the end of the update function
+  // Start controller, will take effect at the beginning of the update function
   std::vector<std::string> start_controllers = {test_controller::TEST_CONTROLLER_NAME};
   std::vector<std::string> stop_controllers = {};
   auto switch_future = std::async(
@@ -192,11 +202,13 @@ TEST_P(TestControllerManager, per_controller_update_rate)
 
   ASSERT_EQ(std::future_status::timeout, switch_future.wait_for(std::chrono::milliseconds(100)))
     << "switch_controller should be blocking until next update cycle";
+  wait_for_prepared_switch(switch_future);
 
   EXPECT_EQ(
     controller_interface::return_type::OK,
     cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)));
-  EXPECT_EQ(0u, test_controller->internal_counter) << "Controller is started at the end of update";
+  EXPECT_EQ(1u, test_controller->internal_counter)
+    << "Controller is started at the beginning of update";
   {
     ControllerManagerRunner cm_runner(this);
     EXPECT_EQ(controller_interface::return_type::OK, switch_future.get());
@@ -215,3 +227,269 @@ Strictness strict{STRICT, controller_interface::return_type::ERROR, 0u};
 Strictness best_effort{BEST_EFFORT, controller_interface::return_type::OK, 1u};
 INSTANTIATE_TEST_SUITE_P(
   test_strict_best_effort, TestControllerManager, testing::Values(strict, best_effort));
+
+class TestControllerManagerParallelUpdate : public ControllerManagerFixture
+{
+public:
+  static void SetUpTestCase()
+  {
+    const char * const argv[] = {"test_controller_manager", "--ros-args", "-p", "update_threads:=2"};
+    rclcpp::init(4, argv);
+  }
+};
+
+TEST_F(TestControllerManagerParallelUpdate, updates_dependent_and_independent_controllers)
+{
+  // the first two controllers depend on each other through joint1/position
+  std::vector<std::shared_ptr<test_controller::TestController>> controllers;
+  const std::vector<std::vector<std::string>> command_interfaces = {
+    {"joint1/position"}, {"joint2/velocity"}, {"joint3/velocity"}};
+  const std::vector<std::vector<std::string>> state_interfaces = {
+    {"joint1/velocity"}, {"joint1/position"}, {"joint3/position"}};
+  std::vector<std::string> controller_names;
+  for (size_t i = 0; i < command_interfaces.size(); ++i)
+  {
+    auto controller = std::make_shared<test_controller::TestController>();
+    controller->set_command_interface_configuration(
+      {controller_interface::interface_configuration_type::INDIVIDUAL, command_interfaces[i]});
+    controller->set_state_interface_configuration(
+      {controller_interface::interface_configuration_type::INDIVIDUAL, state_interfaces[i]});
+    const std::string name = "test_controller" + std::to_string(i);
+    cm_->add_controller(controller, name, test_controller::TEST_CONTROLLER_CLASS_NAME);
+    cm_->configure_controller(name);
+    controllers.push_back(controller);
+    controller_names.push_back(name);
+  }
+
+  {
+    ControllerManagerRunner cm_runner(this);
+    ASSERT_EQ(
+      controller_interface::return_type::OK,
+      cm_->switch_controller(controller_names, {}, STRICT, true, rclcpp::Duration(0, 0)));
+  }
+
+  std::vector<size_t> counters_before;
+  for (const auto & controller : controllers)
+  {
+    EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, controller->get_state().id());
+    counters_before.push_back(controller->internal_counter);
+  }
+  for (int i = 0; i < 100; ++i)
+  {
+    EXPECT_EQ(
+      controller_interface::return_type::OK,
+      cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)));
+  }
+  for (size_t i = 0; i < controllers.size(); ++i)
+  {
+    EXPECT_EQ(counters_before[i] + 100u, controllers[i]->internal_counter);
+  }
+}
+
+class TestControllerManagerCommandModes : public ControllerManagerFixture
+{
+public:
+  void SetUp() override
+  {
+    executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+    // the hardware completes the switch of an interface to velocity mode in the following read
+    cm_ = std::make_shared<controller_manager::ControllerManager>(
+      std::make_unique<hardware_interface::ResourceManager>(robot_description_, true, true),
+      executor_, TEST_CM_NAME);
+    run_updater_ = false;
+
+    position_controller_ = add_controller("position_controller", {"joint1/position"});
+    velocity_controller_ = add_controller("velocity_controller", {"joint2/velocity"});
+  }
+
+  std::shared_ptr<test_controller::TestController> add_controller(
+    const std::string & name, const std::vector<std::string> & command_interfaces)
+  {
+    auto controller = std::make_shared<test_controller::TestController>();
+    controller->set_command_interface_configuration(
+      {controller_interface::interface_configuration_type::INDIVIDUAL, command_interfaces});
+    cm_->add_controller(controller, name, test_controller::TEST_CONTROLLER_CLASS_NAME);
+    cm_->configure_controller(name);
+    return controller;
+  }
+
+  std::future<controller_interface::return_type> start_controllers(
+    int strictness, bool start_asap, const rclcpp::Duration & timeout)
+  {
+    auto switch_future = std::async(
+      std::launch::async, &controller_manager::ControllerManager::switch_controller, cm_,
+      std::vector<std::string>{"position_controller", "velocity_controller"},
+      std::vector<std::string>{}, strictness, start_asap, timeout);
+    wait_for_prepared_switch(switch_future);
+    return switch_future;
+  }
+
+  void update()
+  {
+    EXPECT_EQ(
+      controller_interface::return_type::OK,
+      cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)));
+  }
+
+  /// Run update cycles without reading the hardware until switch_controller() returned.
+  controller_interface::return_type update_until_switched(
+    std::future<controller_interface::return_type> & switch_future)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (switch_future.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        ADD_FAILURE() << "switch_controller did not return";
+        break;
+      }
+      update();
+    }
+    return switch_future.get();
+  }
+
+  std::vector<std::string> get_claimed_interfaces(const std::string & controller_name)
+  {
+    for (const auto & controller : cm_->get_loaded_controllers())
+    {
+      if (controller.info.name == controller_name)
+      {
+        return controller.info.claimed_interfaces;
+      }
+    }
+    return {};
+  }
+
+  std::string robot_description_ = ros2_control_test_assets::command_modes_robot_urdf;
+  std::shared_ptr<test_controller::TestController> position_controller_;
+  std::shared_ptr<test_controller::TestController> velocity_controller_;
+};
+
+TEST_F(TestControllerManagerCommandModes, started_controllers_wait_for_mode_switch)
+{
+  auto switch_future = start_controllers(BEST_EFFORT, false, rclcpp::Duration(0, 0));
+
+  // commit, the switch of joint2 to velocity mode is not done before the next read
+  update();
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, position_controller_->get_state().id());
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, velocity_controller_->get_state().id());
+  update();
+  EXPECT_EQ(0u, position_controller_->internal_counter)
+    << "Started controllers are updated together once all mode switches are done";
+  EXPECT_EQ(0u, velocity_controller_->internal_counter);
+  EXPECT_EQ(std::future_status::timeout, switch_future.wait_for(std::chrono::milliseconds(10)));
+
+  cm_->read();
+  update();
+  EXPECT_EQ(1u, position_controller_->internal_counter);
+  EXPECT_EQ(1u, velocity_controller_->internal_counter);
+  ASSERT_EQ(std::future_status::ready, switch_future.wait_for(std::chrono::seconds(5)));
+  EXPECT_EQ(controller_interface::return_type::OK, switch_future.get());
+}
+
+TEST_F(TestControllerManagerCommandModes, start_asap_releases_controllers_separately)
+{
+  auto switch_future = start_controllers(BEST_EFFORT, true, rclcpp::Duration(0, 0));
+
+  update();
+  EXPECT_EQ(1u, position_controller_->internal_counter)
+    << "The switch of joint1 to position mode is done immediately";
+  EXPECT_EQ(0u, velocity_controller_->internal_counter);
+  update();
+  EXPECT_EQ(2u, position_controller_->internal_counter);
+  EXPECT_EQ(0u, velocity_controller_->internal_counter);
+
+  cm_->read();
+  update();
+  EXPECT_EQ(3u, position_controller_->internal_counter);
+  EXPECT_EQ(1u, velocity_controller_->internal_counter);
+  ASSERT_EQ(std::future_status::ready, switch_future.wait_for(std::chrono::seconds(5)));
+  EXPECT_EQ(controller_interface::return_type::OK, switch_future.get());
+}
+
+TEST_F(TestControllerManagerCommandModes, mode_switch_timeout_deactivates_waiting_controllers)
+{
+  auto switch_future = start_controllers(BEST_EFFORT, true, rclcpp::Duration::from_seconds(0.1));
+
+  // the hardware is never read, so joint2 never completes the switch to velocity mode
+  EXPECT_EQ(controller_interface::return_type::OK, update_until_switched(switch_future));
+  EXPECT_EQ(0u, velocity_controller_->internal_counter);
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, velocity_controller_->get_state().id());
+  EXPECT_TRUE(get_claimed_interfaces("velocity_controller").empty());
+  EXPECT_GT(position_controller_->internal_counter, 0u);
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, position_controller_->get_state().id());
+}
+
+TEST_F(TestControllerManagerCommandModes, mode_switch_timeout_fails_strict_switch)
+{
+  auto switch_future = start_controllers(STRICT, true, rclcpp::Duration::from_seconds(0.1));
+
+  EXPECT_EQ(controller_interface::return_type::ERROR, update_until_switched(switch_future));
+  EXPECT_EQ(0u, velocity_controller_->internal_counter);
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, velocity_controller_->get_state().id());
+  EXPECT_TRUE(get_claimed_interfaces("velocity_controller").empty());
+  // the rest of the switch is not undone
+  EXPECT_GT(position_controller_->internal_counter, 0u);
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, position_controller_->get_state().id());
+  EXPECT_THAT(
+    get_claimed_interfaces("position_controller"), testing::ElementsAre("joint1/position"));
+}
+
+TEST_F(TestControllerManagerCommandModes, mode_switch_without_timeout_is_bounded)
+{
+  cm_->declare_parameter("command_mode_switch_timeout", 0.1);
+  auto switch_future = start_controllers(STRICT, true, rclcpp::Duration(0, 0));
+
+  // the hardware is never read, so joint2 never completes the switch to velocity mode
+  EXPECT_EQ(controller_interface::return_type::ERROR, update_until_switched(switch_future));
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, velocity_controller_->get_state().id());
+  EXPECT_TRUE(get_claimed_interfaces("velocity_controller").empty());
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, position_controller_->get_state().id());
+}
+
+class TestControllerManagerFailingCommandModes : public TestControllerManagerCommandModes
+{
+public:
+  TestControllerManagerFailingCommandModes()
+  {
+    // the hardware fails to perform every mode switch
+    robot_description_ = ros2_control_test_assets::failing_command_modes_robot_urdf;
+  }
+};
+
+TEST_F(TestControllerManagerFailingCommandModes, failed_mode_switch_deactivates_started_controllers)
+{
+  auto switch_future = start_controllers(BEST_EFFORT, false, rclcpp::Duration(0, 0));
+
+  // the switch returns right after the commit instead of waiting for the mode switch
+  EXPECT_EQ(controller_interface::return_type::OK, update_until_switched(switch_future));
+  update();
+  for (const auto & controller : {position_controller_, velocity_controller_})
+  {
+    EXPECT_EQ(0u, controller->internal_counter);
+    EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, controller->get_state().id());
+  }
+  EXPECT_TRUE(get_claimed_interfaces("position_controller").empty());
+  EXPECT_TRUE(get_claimed_interfaces("velocity_controller").empty());
+}
+
+TEST_F(TestControllerManagerFailingCommandModes, failed_mode_switch_fails_strict_switch)
+{
+  auto switch_future = start_controllers(STRICT, true, rclcpp::Duration(0, 0));
+
+  EXPECT_EQ(controller_interface::return_type::ERROR, update_until_switched(switch_future));
+  update();
+  for (const auto & controller : {position_controller_, velocity_controller_})
+  {
+    EXPECT_EQ(0u, controller->internal_counter);
+    EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, controller->get_state().id());
+  }
+}
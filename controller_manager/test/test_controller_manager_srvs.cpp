@@ -14,8 +14,10 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "controller_manager_test_common.hpp"
@@ -24,6 +26,7 @@
 #include "controller_manager/controller_manager.hpp"
 #include "controller_manager_msgs/srv/list_controller_types.hpp"
 #include "controller_manager_msgs/srv/list_controllers.hpp"
+#include "controller_manager_msgs/srv/set_active_controllers.hpp"
 #include "controller_manager_msgs/srv/switch_controller.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 
@@ -184,6 +187,52 @@ TEST_F(TestControllerManagerSrvs, list_controllers_srv)
   ASSERT_EQ(0u, result->controller.size());
 }
 
+TEST_F(TestControllerManagerSrvs, list_controllers_update_statistics_srv)
+{
+  rclcpp::executors::SingleThreadedExecutor srv_executor;
+  rclcpp::Node::SharedPtr srv_node = std::make_shared<rclcpp::Node>("srv_client");
+  srv_executor.add_node(srv_node);
+  rclcpp::Client<controller_manager_msgs::srv::ListControllers>::SharedPtr client =
+    srv_node->create_client<controller_manager_msgs::srv::ListControllers>(
+      "test_controller_manager/list_controllers");
+  auto request = std::make_shared<controller_manager_msgs::srv::ListControllers::Request>();
+
+  auto test_controller = std::make_shared<test_controller::TestController>();
+  cm_->add_controller(
+    test_controller, test_controller::TEST_CONTROLLER_NAME,
+    test_controller::TEST_CONTROLLER_CLASS_NAME);
+  cm_->configure_controller(test_controller::TEST_CONTROLLER_NAME);
+
+  // inactive controllers are not updated
+  auto result = call_service_and_wait(*client, request, srv_executor);
+  ASSERT_EQ(1u, result->controller.size());
+  const auto & inactive_statistics = result->controller[0].update_statistics;
+  EXPECT_EQ(0u, inactive_statistics.update_count);
+  EXPECT_EQ(0.0, inactive_statistics.mean);
+  EXPECT_EQ(0u, inactive_statistics.overrun_count);
+  // the budget defaults to the period of the update loop
+  EXPECT_DOUBLE_EQ(1.0 / cm_->get_update_rate(), inactive_statistics.budget);
+
+  cm_->switch_controller(
+    {test_controller::TEST_CONTROLLER_NAME}, {},
+    controller_manager_msgs::srv::SwitchController::Request::STRICT, true, rclcpp::Duration(0, 0));
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (test_controller->internal_counter < 5u && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_GE(test_controller->internal_counter, 5u) << "The controller was not updated in time";
+
+  result = call_service_and_wait(*client, request, srv_executor);
+  ASSERT_EQ(1u, result->controller.size());
+  const auto & statistics = result->controller[0].update_statistics;
+  EXPECT_GE(statistics.update_count, 5u);
+  EXPECT_LE(statistics.last, statistics.max);
+  EXPECT_LE(statistics.mean, statistics.max);
+  EXPECT_GT(statistics.max, 0.0);
+  EXPECT_LE(statistics.overrun_count, statistics.update_count);
+}
+
 TEST_F(TestControllerManagerSrvs, reload_controller_libraries_srv)
 {
   rclcpp::executors::SingleThreadedExecutor srv_executor;
@@ -308,6 +357,44 @@ TEST_F(TestControllerManagerSrvs, load_controller_srv)
     cm_->get_loaded_controllers()[0].c->get_state().id());
 }
 
+TEST_F(TestControllerManagerSrvs, load_controllers_srv)
+{
+  rclcpp::executors::SingleThreadedExecutor srv_executor;
+  rclcpp::Node::SharedPtr srv_node = std::make_shared<rclcpp::Node>("srv_client");
+  srv_executor.add_node(srv_node);
+  rclcpp::Client<controller_manager_msgs::srv::LoadControllers>::SharedPtr client =
+    srv_node->create_client<controller_manager_msgs::srv::LoadControllers>(
+      "test_controller_manager/load_controllers");
+
+  const std::vector<std::string> controller_names = {
+    "test_controller_1", "test_controller_2", "test_controller_3", "test_controller_4"};
+  for (const auto & controller_name : controller_names)
+  {
+    cm_->set_parameter(
+      rclcpp::Parameter(controller_name + ".type", test_controller::TEST_CONTROLLER_CLASS_NAME));
+  }
+
+  auto request = std::make_shared<controller_manager_msgs::srv::LoadControllers::Request>();
+  request->names = controller_names;
+  request->names.push_back("test_controller_without_type");
+  auto result = call_service_and_wait(*client, request, srv_executor, true);
+  EXPECT_FALSE(result->ok) << "There's no param specifying the type for the last controller";
+  EXPECT_THAT(result->loaded_controllers, testing::ElementsAreArray(controller_names));
+  ASSERT_EQ(controller_names.size(), cm_->get_loaded_controllers().size());
+  for (const auto & controller : cm_->get_loaded_controllers())
+  {
+    EXPECT_EQ(
+      lifecycle_msgs::msg::State::PRIMARY_STATE_UNCONFIGURED, controller.c->get_state().id());
+  }
+
+  // loading already loaded controllers fails
+  request->names = {controller_names[0]};
+  result = call_service_and_wait(*client, request, srv_executor, true);
+  EXPECT_FALSE(result->ok);
+  EXPECT_TRUE(result->loaded_controllers.empty());
+  EXPECT_EQ(controller_names.size(), cm_->get_loaded_controllers().size());
+}
+
 TEST_F(TestControllerManagerSrvs, unload_controller_srv)
 {
   rclcpp::executors::SingleThreadedExecutor srv_executor;
@@ -441,3 +528,64 @@ TEST_F(TestControllerManagerSrvs, configure_start_controller_srv)
     lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE,
     cm_->get_loaded_controllers()[0].c->get_state().id());
 }
+
+TEST_F(TestControllerManagerSrvs, set_active_controllers_srv)
+{
+  rclcpp::executors::SingleThreadedExecutor srv_executor;
+  rclcpp::Node::SharedPtr srv_node = std::make_shared<rclcpp::Node>("srv_client");
+  srv_executor.add_node(srv_node);
+  rclcpp::Client<controller_manager_msgs::srv::SetActiveControllers>::SharedPtr client =
+    srv_node->create_client<controller_manager_msgs::srv::SetActiveControllers>(
+      "test_controller_manager/set_active_controllers");
+
+  constexpr char TEST_CONTROLLER2_NAME[] = "test_controller2_name";
+  auto test_controller = std::make_shared<test_controller::TestController>();
+  cm_->add_controller(
+    test_controller, test_controller::TEST_CONTROLLER_NAME,
+    test_controller::TEST_CONTROLLER_CLASS_NAME);
+  auto test_controller2 = std::make_shared<test_controller::TestController>();
+  cm_->add_controller(
+    test_controller2, TEST_CONTROLLER2_NAME, test_controller::TEST_CONTROLLER_CLASS_NAME);
+  cm_->configure_controller(test_controller::TEST_CONTROLLER_NAME);
+
+  // the unconfigured controller is configured, both are started with one switch
+  auto request = std::make_shared<controller_manager_msgs::srv::SetActiveControllers::Request>();
+  request->active_controllers = {test_controller::TEST_CONTROLLER_NAME, TEST_CONTROLLER2_NAME};
+  request->strictness = controller_manager_msgs::srv::SetActiveControllers::Request::STRICT;
+  auto result = call_service_and_wait(*client, request, srv_executor, true);
+  ASSERT_TRUE(result->ok);
+  EXPECT_THAT(
+    result->started_controllers,
+    testing::UnorderedElementsAre(test_controller::TEST_CONTROLLER_NAME, TEST_CONTROLLER2_NAME));
+  EXPECT_TRUE(result->stopped_controllers.empty());
+  EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, test_controller->get_state().id());
+  EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, test_controller2->get_state().id());
+
+  // only the difference to the target is switched
+  request->active_controllers = {TEST_CONTROLLER2_NAME};
+  request->exclusive = true;
+  result = call_service_and_wait(*client, request, srv_executor, true);
+  ASSERT_TRUE(result->ok);
+  EXPECT_TRUE(result->started_controllers.empty());
+  EXPECT_THAT(
+    result->stopped_controllers, testing::ElementsAre(test_controller::TEST_CONTROLLER_NAME));
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, test_controller->get_state().id());
+  EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, test_controller2->get_state().id());
+
+  // nothing to switch
+  result = call_service_and_wait(*client, request, srv_executor, true);
+  ASSERT_TRUE(result->ok);
+  EXPECT_TRUE(result->started_controllers.empty());
+  EXPECT_TRUE(result->stopped_controllers.empty());
+
+  // unknown controllers and contradicting targets are rejected
+  request->active_controllers = {"unknown_controller"};
+  result = call_service_and_wait(*client, request, srv_executor, true);
+  EXPECT_FALSE(result->ok);
+  request->active_controllers = {TEST_CONTROLLER2_NAME};
+  request->inactive_controllers = {TEST_CONTROLLER2_NAME};
+  result = call_service_and_wait(*client, request, srv_executor, true);
+  EXPECT_FALSE(result->ok);
+  EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, test_controller2->get_state().id());
+}
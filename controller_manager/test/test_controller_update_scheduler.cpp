@@ -0,0 +1,109 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <vector>
+
+#include "controller_manager/controller_update_scheduler.hpp"
+
+using controller_manager::ControllerUpdateScheduler;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr auto kLoopPeriod = std::chrono::nanoseconds(10ms);
+
+/// Cycles in which the scheduler is due during the given number of cycles
+std::vector<int> due_cycles(ControllerUpdateScheduler & scheduler, int cycles)
+{
+  std::vector<int> result;
+  std::chrono::nanoseconds elapsed{0};
+  for (int cycle = 0; cycle < cycles; ++cycle)
+  {
+    if (scheduler.advance(kLoopPeriod, kLoopPeriod, elapsed))
+    {
+      result.push_back(cycle);
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST(TestControllerUpdateScheduler, updates_in_every_cycle_without_controller_period)
+{
+  ControllerUpdateScheduler scheduler;
+  scheduler.reset(0ns, 0ns);
+  std::chrono::nanoseconds elapsed{0};
+  for (int cycle = 0; cycle < 10; ++cycle)
+  {
+    ASSERT_TRUE(scheduler.advance(9ms, kLoopPeriod, elapsed));
+    EXPECT_EQ(9ms, elapsed);
+  }
+}
+
+TEST(TestControllerUpdateScheduler, decimates_evenly_divided_rate)
+{
+  ControllerUpdateScheduler scheduler;
+  // 25 Hz in a 100 Hz loop, first update in the first cycle
+  scheduler.reset(40ms, kLoopPeriod);
+  EXPECT_THAT(due_cycles(scheduler, 13), testing::ElementsAre(0, 4, 8, 12));
+}
+
+TEST(TestControllerUpdateScheduler, keeps_rate_which_does_not_divide_loop_rate)
+{
+  ControllerUpdateScheduler scheduler;
+  // 30 Hz in a 100 Hz loop
+  scheduler.reset(std::chrono::nanoseconds(1000000000 / 30), kLoopPeriod);
+  std::chrono::nanoseconds elapsed{0};
+  std::chrono::nanoseconds total_elapsed{0};
+  int updates = 0;
+  for (int cycle = 0; cycle < 1000; ++cycle)
+  {
+    if (scheduler.advance(kLoopPeriod, kLoopPeriod, elapsed))
+    {
+      ++updates;
+      total_elapsed += elapsed;
+      // the controller gets the elapsed time instead of its nominal period
+      EXPECT_TRUE(elapsed == 10ms || elapsed == 30ms || elapsed == 40ms) << elapsed.count();
+    }
+  }
+  EXPECT_EQ(300, updates);
+  EXPECT_LE(total_elapsed, 10s);
+  EXPECT_GE(total_elapsed, 10s - 40ms);
+}
+
+TEST(TestControllerUpdateScheduler, staggers_controllers_with_first_update)
+{
+  ControllerUpdateScheduler first, second;
+  first.reset(40ms, kLoopPeriod);
+  second.reset(40ms, 2 * kLoopPeriod);
+  EXPECT_THAT(due_cycles(first, 9), testing::ElementsAre(0, 4, 8));
+  EXPECT_THAT(due_cycles(second, 9), testing::ElementsAre(1, 5));
+}
+
+TEST(TestControllerUpdateScheduler, skips_updates_missed_by_stalled_loop)
+{
+  ControllerUpdateScheduler scheduler;
+  scheduler.reset(40ms, kLoopPeriod);
+  EXPECT_THAT(due_cycles(scheduler, 2), testing::ElementsAre(0));
+
+  // the loop stalls for a second, the controller is updated only once and stays on its grid
+  std::chrono::nanoseconds elapsed{0};
+  ASSERT_TRUE(scheduler.advance(1s, kLoopPeriod, elapsed));
+  EXPECT_EQ(1s + kLoopPeriod, elapsed);
+  // next deadlines are at 1040 ms and 1080 ms, i.e., in the third and seventh following cycle
+  EXPECT_THAT(due_cycles(scheduler, 9), testing::ElementsAre(2, 6));
+}
@@ -0,0 +1,174 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "controller_manager/interface_recorder.hpp"
+
+using controller_manager::InterfaceRecorder;
+using namespace std::chrono_literals;
+
+namespace
+{
+template <typename T>
+T read_at(const std::vector<char> & file, size_t offset)
+{
+  T value;
+  std::memcpy(&value, file.data() + offset, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+class TestInterfaceRecorder : public ::testing::Test
+{
+protected:
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  std::vector<char> read_file() const
+  {
+    std::ifstream stream(path_, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(stream), {});
+  }
+
+  const std::string path_ = "/tmp/test_interface_recorder.rec";
+};
+
+TEST_F(TestInterfaceRecorder, rejects_empty_ring)
+{
+  InterfaceRecorder recorder;
+  EXPECT_FALSE(recorder.open(path_, {}, 1, 0));
+  EXPECT_FALSE(recorder.is_open());
+}
+
+TEST_F(TestInterfaceRecorder, records_cycles_to_ring_in_mapped_file)
+{
+  hardware_interface::StateSnapshotLayout layout;
+  layout.state_interfaces.push_back(
+    {"joint1/position", 0, 1, hardware_interface::HandleDataType::DOUBLE});
+  layout.state_interfaces.push_back(
+    {"skin/taxels", 1, 2, hardware_interface::HandleDataType::DOUBLE});
+  layout.command_interfaces.push_back(
+    {"joint1/position", 8, 1, hardware_interface::HandleDataType::DOUBLE});
+  constexpr size_t kValueCount = 9;
+
+  InterfaceRecorder recorder;
+  ASSERT_TRUE(recorder.open(path_, layout, kValueCount, 2));
+  ASSERT_TRUE(recorder.is_open());
+  std::vector<double> values(kValueCount);
+  for (int cycle = 0; cycle < 3; ++cycle)
+  {
+    for (size_t i = 0; i < kValueCount; ++i)
+    {
+      values[i] = cycle * 100.0 + static_cast<double>(i);
+    }
+    recorder.commit(values.data(), cycle * 1ms, 10us, 20us, 30us);
+  }
+  EXPECT_EQ(3u, recorder.get_record_count());
+
+  const auto file = read_file();
+  ASSERT_GE(file.size(), sizeof(InterfaceRecorder::FileHeader));
+  const auto header = read_at<InterfaceRecorder::FileHeader>(file, 0);
+  EXPECT_EQ(0, std::memcmp(header.magic, InterfaceRecorder::kMagic, sizeof(header.magic)));
+  EXPECT_EQ(InterfaceRecorder::kFormatVersion, header.format_version);
+  EXPECT_EQ(3u, header.interface_count);
+  EXPECT_EQ(2u, header.capacity);
+  // the padding between the values is not recorded
+  EXPECT_EQ(4u, header.value_count);
+  EXPECT_EQ(sizeof(InterfaceRecorder::RecordHeader) + 4 * sizeof(double), header.record_size);
+  EXPECT_EQ(3u, header.record_count);
+  EXPECT_EQ(header.records_offset + 2 * header.record_size, file.size());
+
+  // interface names are stored once in the header
+  size_t offset = sizeof(InterfaceRecorder::FileHeader);
+  std::vector<std::string> names;
+  std::vector<uint64_t> indexes;
+  for (uint32_t i = 0; i < header.interface_count; ++i)
+  {
+    const auto interface = read_at<InterfaceRecorder::InterfaceHeader>(file, offset);
+    offset += sizeof(InterfaceRecorder::InterfaceHeader);
+    names.emplace_back(file.data() + offset, interface.name_length);
+    offset += interface.name_length;
+    indexes.push_back(interface.index);
+    EXPECT_EQ(i == 2 ? 1u : 0u, interface.is_command);
+  }
+  EXPECT_THAT(names, ::testing::ElementsAre("joint1/position", "skin/taxels", "joint1/position"));
+  EXPECT_THAT(indexes, ::testing::ElementsAre(0u, 1u, 3u));
+
+  // the third record overwrote the first one
+  const size_t third = header.records_offset;
+  const auto record = read_at<InterfaceRecorder::RecordHeader>(file, third);
+  EXPECT_EQ(std::chrono::nanoseconds(2ms).count(), record.stamp);
+  EXPECT_EQ(std::chrono::nanoseconds(10us).count(), record.read_time);
+  EXPECT_EQ(std::chrono::nanoseconds(20us).count(), record.update_time);
+  EXPECT_EQ(std::chrono::nanoseconds(30us).count(), record.write_time);
+  EXPECT_EQ(208.0, read_at<double>(file, third + sizeof(record) + 3 * sizeof(double)));
+  const size_t second = header.records_offset + header.record_size;
+  EXPECT_EQ(101.0, read_at<double>(file, second + sizeof(record) + sizeof(double)));
+}
+
+TEST_F(TestInterfaceRecorder, recording_converts_to_csv)
+{
+  hardware_interface::StateSnapshotLayout layout;
+  layout.state_interfaces.push_back(
+    {"joint1/position", 0, 1, hardware_interface::HandleDataType::DOUBLE});
+  layout.state_interfaces.push_back(
+    {"skin/taxels", 8, 2, hardware_interface::HandleDataType::DOUBLE});
+  layout.command_interfaces.push_back(
+    {"gripper/open", 16, 1, hardware_interface::HandleDataType::BOOL});
+  constexpr size_t kValueCount = 17;
+
+  InterfaceRecorder recorder;
+  ASSERT_TRUE(recorder.open(path_, layout, kValueCount, 2));
+  std::vector<double> values(kValueCount);
+  for (int cycle = 0; cycle < 3; ++cycle)
+  {
+    values[0] = cycle + 0.5;
+    values[8] = cycle * 10.0;
+    values[9] = cycle * 10.0 + 1.0;
+    // typed values are stored at the start of their value
+    const bool open = cycle % 2 == 1;
+    std::memcpy(&values[16], &open, sizeof(open));
+    recorder.commit(values.data(), cycle * 1ms, 10us, 20us, 30us);
+  }
+
+  const std::string csv_path = path_ + ".csv";
+  const std::string command =
+    std::string("python3 ") + RECORDING_TO_CSV_SCRIPT + " " + path_ + " -o " + csv_path;
+  ASSERT_EQ(0, std::system(command.c_str()));
+  std::ifstream csv(csv_path);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(csv, line);)
+  {
+    lines.push_back(line);
+  }
+  std::remove(csv_path.c_str());
+
+  // the ring only holds the last two cycles
+  EXPECT_THAT(
+    lines, ::testing::ElementsAre(
+             "cycle,stamp,read_time,update_time,write_time,state/joint1/position,"
+             "state/skin/taxels[0],state/skin/taxels[1],command/gripper/open\r",
+             "1,1000000,10000,20000,30000,1.5,10.0,11.0,True\r",
+             "2,2000000,10000,20000,30000,2.5,20.0,21.0,False\r"));
+}
@@ -0,0 +1,103 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "controller_manager/latency_histogram.hpp"
+
+using controller_manager::LatencyHistogram;
+using namespace std::chrono_literals;
+
+TEST(TestLatencyHistogram, buckets_cover_values_with_bounded_error)
+{
+  for (uint64_t value : std::vector<uint64_t>{0u, 1u, 15u, 16u, 17u, 31u, 32u, 1000u, 123456789u})
+  {
+    const auto index = LatencyHistogram::bucket_index(value);
+    ASSERT_LT(index, LatencyHistogram::kBucketCount);
+    EXPECT_LE(LatencyHistogram::bucket_lower_bound(index), value);
+    EXPECT_GT(
+      LatencyHistogram::bucket_lower_bound(index) + LatencyHistogram::bucket_width(index), value);
+    EXPECT_LE(
+      LatencyHistogram::bucket_width(index),
+      std::max<uint64_t>(1u, value / LatencyHistogram::kSubBuckets));
+  }
+  EXPECT_EQ(LatencyHistogram::kBucketCount - 1, LatencyHistogram::bucket_index(UINT64_MAX));
+}
+
+TEST(TestLatencyHistogram, empty_histogram_has_no_samples)
+{
+  LatencyHistogram histogram;
+  const auto statistics = histogram.drain();
+  EXPECT_EQ(0u, statistics.sample_count);
+  EXPECT_EQ(0ns, statistics.max);
+}
+
+TEST(TestLatencyHistogram, computes_statistics_and_resets_on_drain)
+{
+  LatencyHistogram histogram;
+  // 990 fast samples, 9 slow samples and one outlier
+  for (int i = 0; i < 990; ++i)
+  {
+    histogram.record(100us);
+  }
+  for (int i = 0; i < 9; ++i)
+  {
+    histogram.record(1ms);
+  }
+  histogram.record(10ms);
+
+  auto statistics = histogram.drain();
+  EXPECT_EQ(1000u, statistics.sample_count);
+  EXPECT_EQ(100us, statistics.min);
+  EXPECT_EQ(10ms, statistics.max);
+  EXPECT_EQ(
+    std::chrono::nanoseconds((990 * 100000 + 9 * 1000000 + 10000000) / 1000), statistics.mean);
+  EXPECT_NEAR(100000, statistics.p99.count(), 100000 / LatencyHistogram::kSubBuckets);
+  EXPECT_NEAR(1000000, statistics.p999.count(), 1000000 / LatencyHistogram::kSubBuckets);
+
+  statistics = histogram.drain();
+  EXPECT_EQ(0u, statistics.sample_count);
+}
+
+TEST(TestLatencyHistogram, concurrent_recording_does_not_lose_samples)
+{
+  LatencyHistogram histogram;
+  constexpr int kSamplesPerThread = 100000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&histogram]() {
+      for (int i = 0; i < kSamplesPerThread; ++i)
+      {
+        histogram.record(std::chrono::nanoseconds(i));
+      }
+    });
+  }
+  uint64_t drained_samples = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    drained_samples += histogram.drain().sample_count;
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  drained_samples += histogram.drain().sample_count;
+  EXPECT_EQ(4u * kSamplesPerThread, drained_samples);
+}
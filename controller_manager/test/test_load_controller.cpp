@@ -424,6 +424,42 @@ TEST_F(TestTwoLoadedControllers, switch_multiple_controllers)
   ASSERT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, controller_if2->get_state().id());
 }
 
+TEST_F(TestLoadController, load_controllers_without_waiting_for_update_loop)
+{
+  auto controller_if1 = std::make_shared<test_controller::TestController>();
+  ASSERT_NE(
+    cm_->add_controller(controller_if1, controller_name1, TEST_CONTROLLER_CLASS_NAME), nullptr);
+  cm_->configure_controller(controller_name1);
+  _switch_test_controllers(strvec{controller_name1}, strvec{});
+  ASSERT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, controller_if1->get_state().id());
+
+  // the update loop is stopped while using the current controller list, loading inactive
+  // controllers does not wait for it
+  auto load_future2 = std::async(std::launch::async, [this]() {
+    return cm_->load_controller(controller_name2, TEST_CONTROLLER_CLASS_NAME);
+  });
+  auto load_future3 = std::async(std::launch::async, [this]() {
+    return cm_->load_controller("test_controller3", TEST_CONTROLLER_CLASS_NAME);
+  });
+  ASSERT_EQ(std::future_status::ready, load_future2.wait_for(std::chrono::milliseconds(100)));
+  ASSERT_EQ(std::future_status::ready, load_future3.wait_for(std::chrono::milliseconds(100)));
+  auto controller_if2 = load_future2.get();
+  ASSERT_NE(controller_if2, nullptr);
+  ASSERT_NE(load_future3.get(), nullptr);
+  EXPECT_EQ(3u, cm_->get_loaded_controllers().size());
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_UNCONFIGURED, controller_if2->get_state().id());
+
+  // the already active controller keeps being updated
+  const auto update_count = controller_if1->internal_counter;
+  cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01));
+  EXPECT_EQ(update_count + 1, controller_if1->internal_counter);
+
+  // duplicates are still rejected
+  EXPECT_EQ(cm_->load_controller(controller_name2, TEST_CONTROLLER_CLASS_NAME), nullptr);
+  EXPECT_EQ(3u, cm_->get_loaded_controllers().size());
+}
+
 TEST_F(TestLoadController, can_set_and_get_non_default_update_rate)
 {
   auto controller_if =
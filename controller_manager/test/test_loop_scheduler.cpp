@@ -0,0 +1,67 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "controller_manager/loop_scheduler.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(TestLoopScheduler, rejects_invalid_period)
+{
+  EXPECT_THROW(controller_manager::LoopScheduler(0ns), std::invalid_argument);
+  EXPECT_THROW(controller_manager::LoopScheduler(-1ms), std::invalid_argument);
+}
+
+TEST(TestLoopScheduler, sleeps_until_absolute_deadlines)
+{
+  controller_manager::LoopScheduler scheduler(2ms);
+  EXPECT_EQ(2ms, scheduler.get_period());
+
+  const auto start = std::chrono::steady_clock::now();
+  scheduler.start();
+  for (int i = 0; i < 10; ++i)
+  {
+    // work shorter than the period must not shift the following deadlines
+    std::this_thread::sleep_for(500us);
+    scheduler.sleep_until_next_period();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_GE(elapsed, 20ms);
+  // deadlines may still be missed on a loaded machine, then the loop skips to the next one
+  EXPECT_LE(elapsed, 20ms + 2ms * static_cast<int64_t>(scheduler.get_overrun_count()) + 10ms);
+}
+
+TEST(TestLoopScheduler, counts_missed_deadlines)
+{
+  controller_manager::LoopScheduler scheduler(1ms);
+  scheduler.start();
+  EXPECT_EQ(0u, scheduler.get_overrun_count());
+
+  // a cycle taking five and a half periods misses five deadlines
+  std::this_thread::sleep_for(5500us);
+  EXPECT_FALSE(scheduler.sleep_until_next_period());
+  EXPECT_GE(scheduler.get_overrun_count(), 5u);
+  EXPECT_GE(scheduler.get_last_overrun(), 4ms);
+
+  // restarting the scheduler resets the statistics
+  scheduler.start();
+  EXPECT_EQ(0u, scheduler.get_overrun_count());
+  EXPECT_EQ(0ns, scheduler.get_last_overrun());
+}
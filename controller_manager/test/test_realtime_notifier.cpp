@@ -0,0 +1,69 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "controller_manager/realtime_notifier.hpp"
+
+using controller_manager::RealtimeNotifier;
+using namespace std::chrono_literals;
+
+TEST(TestRealtimeNotifier, returns_immediately_if_condition_holds)
+{
+  RealtimeNotifier notifier;
+  EXPECT_TRUE(notifier.wait([]() { return true; }, []() { return false; }));
+  // notifying without waiters is a no-op
+  notifier.notify();
+}
+
+TEST(TestRealtimeNotifier, aborts_waiting)
+{
+  RealtimeNotifier notifier;
+  EXPECT_FALSE(notifier.wait([]() { return false; }, []() { return true; }));
+
+  std::atomic_bool abort{false};
+  std::thread aborter([&abort]() {
+    std::this_thread::sleep_for(20ms);
+    abort = true;
+  });
+  EXPECT_FALSE(notifier.wait([]() { return false; }, [&abort]() { return abort.load(); }));
+  aborter.join();
+}
+
+TEST(TestRealtimeNotifier, wakes_up_waiters_on_notify)
+{
+  RealtimeNotifier notifier;
+  std::atomic_bool done{false};
+  std::atomic_bool stop{false};
+  // notify in a loop like the real-time thread, which notifies in every cycle
+  std::thread rt_thread([&]() {
+    for (int cycle = 0; !stop; ++cycle)
+    {
+      if (cycle == 10)
+      {
+        done = true;
+      }
+      notifier.notify();
+      std::this_thread::sleep_for(1ms);
+    }
+  });
+
+  EXPECT_TRUE(notifier.wait([&done]() { return done.load(); }, []() { return false; }));
+  stop = true;
+  rt_thread.join();
+}
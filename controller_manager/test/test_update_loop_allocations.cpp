@@ -0,0 +1,162 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "controller_manager/controller_manager.hpp"
+#include "controller_manager_test_common.hpp"
+#include "test_controller/test_controller.hpp"
+
+namespace
+{
+// only allocations of the thread running the update loop are counted
+thread_local bool count_allocations = false;
+std::atomic<size_t> allocation_count{0};
+
+void * counting_allocate(std::size_t size)
+{
+  if (count_allocations)
+  {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  void * ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+class AllocationCounter
+{
+public:
+  AllocationCounter()
+  {
+    allocation_count = 0;
+    count_allocations = true;
+  }
+  ~AllocationCounter() { count_allocations = false; }
+
+  size_t get_count() const { return allocation_count.load(std::memory_order_relaxed); }
+};
+}  // namespace
+
+void * operator new(std::size_t size) { return counting_allocate(size); }
+void * operator new[](std::size_t size) { return counting_allocate(size); }
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+void operator delete[](void * ptr) noexcept { std::free(ptr); }
+void operator delete(void * ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void * ptr, std::size_t) noexcept { std::free(ptr); }
+
+class TestUpdateLoopAllocations : public ControllerManagerFixture
+{
+};
+
+TEST_F(TestUpdateLoopAllocations, update_does_not_allocate)
+{
+  constexpr char TEST_CONTROLLER2_NAME[] = "test_controller2_name";
+  auto active_controller = std::make_shared<test_controller::TestController>();
+  auto inactive_controller = std::make_shared<test_controller::TestController>();
+  cm_->add_controller(
+    active_controller, test_controller::TEST_CONTROLLER_NAME,
+    test_controller::TEST_CONTROLLER_CLASS_NAME);
+  cm_->add_controller(
+    inactive_controller, TEST_CONTROLLER2_NAME, test_controller::TEST_CONTROLLER_CLASS_NAME);
+  cm_->configure_controller(test_controller::TEST_CONTROLLER_NAME);
+  cm_->configure_controller(TEST_CONTROLLER2_NAME);
+
+  startCmUpdater();
+  ASSERT_EQ(
+    controller_interface::return_type::OK,
+    cm_->switch_controller({test_controller::TEST_CONTROLLER_NAME}, {}, STRICT));
+  stopCmUpdater();
+
+  const auto time = rclcpp::Time(0);
+  const auto period = rclcpp::Duration::from_seconds(0.01);
+  // warm up, e.g., lazily initialized statics
+  cm_->update(time, period);
+
+  const auto counter_before = active_controller->internal_counter;
+  size_t allocations = 0;
+  {
+    AllocationCounter counter;
+    for (int i = 0; i < 1000; ++i)
+    {
+      cm_->update(time, period);
+    }
+    allocations = counter.get_count();
+  }
+
+  EXPECT_EQ(0u, allocations);
+  EXPECT_EQ(counter_before + 1000u, active_controller->internal_counter);
+  EXPECT_EQ(0u, inactive_controller->internal_counter);
+}
+
+TEST_F(TestUpdateLoopAllocations, switching_controllers_does_not_allocate_in_update)
+{
+  constexpr char TEST_CONTROLLER2_NAME[] = "test_controller2_name";
+  auto first_controller = std::make_shared<test_controller::TestController>();
+  auto second_controller = std::make_shared<test_controller::TestController>();
+  // both controllers claim the same interface, which is handed over by the switch
+  controller_interface::InterfaceConfiguration command_interfaces = {
+    controller_interface::interface_configuration_type::INDIVIDUAL, {"joint1/position"}};
+  first_controller->set_command_interface_configuration(command_interfaces);
+  second_controller->set_command_interface_configuration(command_interfaces);
+  cm_->add_controller(
+    first_controller, test_controller::TEST_CONTROLLER_NAME,
+    test_controller::TEST_CONTROLLER_CLASS_NAME);
+  cm_->add_controller(
+    second_controller, TEST_CONTROLLER2_NAME, test_controller::TEST_CONTROLLER_CLASS_NAME);
+  cm_->configure_controller(test_controller::TEST_CONTROLLER_NAME);
+  cm_->configure_controller(TEST_CONTROLLER2_NAME);
+
+  // lifecycle transitions and claiming interfaces are done by the thread switching controllers
+  std::atomic_bool run_updater{true};
+  size_t allocations = 0;
+  std::thread updater([&]() {
+    AllocationCounter counter;
+    while (run_updater)
+    {
+      cm_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01));
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    allocations = counter.get_count();
+  });
+  EXPECT_EQ(
+    controller_interface::return_type::OK,
+    cm_->switch_controller({test_controller::TEST_CONTROLLER_NAME}, {}, STRICT));
+  EXPECT_EQ(
+    controller_interface::return_type::OK,
+    cm_->switch_controller(
+      {TEST_CONTROLLER2_NAME}, {test_controller::TEST_CONTROLLER_NAME}, STRICT));
+  run_updater = false;
+  updater.join();
+
+  EXPECT_EQ(0u, allocations);
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE, first_controller->get_state().id());
+  EXPECT_EQ(lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, second_controller->get_state().id());
+  EXPECT_GT(first_controller->internal_counter, 0u);
+  // the started controller was updated in the cycle committing the switch
+  EXPECT_GT(second_controller->internal_counter, 0u);
+}
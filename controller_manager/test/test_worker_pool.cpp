@@ -0,0 +1,136 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "controller_manager/loop_scheduler.hpp"
+#include "controller_manager/worker_pool.hpp"
+
+using controller_manager::WorkerPool;
+
+TEST(TestWorkerPool, runs_tasks_on_calling_thread_without_workers)
+{
+  WorkerPool pool(0);
+  EXPECT_EQ(0u, pool.get_thread_count());
+  EXPECT_TRUE(pool.is_configured());
+
+  const auto caller = std::this_thread::get_id();
+  size_t executed = 0;
+  auto task = [&](size_t) {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    ++executed;
+  };
+  pool.run(5, task);
+  EXPECT_EQ(5u, executed);
+}
+
+TEST(TestWorkerPool, runs_every_task_exactly_once)
+{
+  WorkerPool pool(3);
+  EXPECT_EQ(3u, pool.get_thread_count());
+
+  std::array<std::atomic<int>, 7> executions;
+  for (auto & execution : executions)
+  {
+    execution = 0;
+  }
+  auto task = [&](size_t index) { ++executions[index]; };
+  for (int run = 0; run < 1000; ++run)
+  {
+    pool.run(executions.size(), task);
+    // run() is a barrier, all tasks of this run are done
+    for (const auto & execution : executions)
+    {
+      ASSERT_EQ(run + 1, execution.load());
+    }
+  }
+}
+
+TEST(TestWorkerPool, runs_tasks_concurrently)
+{
+  WorkerPool pool(3);
+
+  // every task waits until all tasks started, which only succeeds if they run concurrently
+  std::atomic<size_t> started_tasks{0};
+  std::atomic<size_t> timed_out_tasks{0};
+  auto task = [&](size_t) {
+    ++started_tasks;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (started_tasks.load() < 4)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        ++timed_out_tasks;
+        return;
+      }
+    }
+  };
+  pool.run(4, task);
+  EXPECT_EQ(4u, started_tasks.load());
+  EXPECT_EQ(0u, timed_out_tasks.load());
+}
+
+TEST(TestWorkerPool, wakes_up_blocked_threads)
+{
+  WorkerPool pool(2);
+
+  std::array<std::atomic<int>, 3> executions;
+  for (auto & execution : executions)
+  {
+    execution = 0;
+  }
+  auto task = [&](size_t index) {
+    // tasks taking longer than the bounded spinning block the caller
+    std::this_thread::sleep_for(std::chrono::milliseconds(index == 0 ? 0 : 5));
+    ++executions[index];
+  };
+  for (int run = 0; run < 10; ++run)
+  {
+    // the workers are blocked when the next run is published
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pool.run(executions.size(), task);
+    for (const auto & execution : executions)
+    {
+      ASSERT_EQ(run + 1, execution.load());
+    }
+  }
+}
+
+TEST(TestWorkerPool, shares_cpu_with_caller)
+{
+  // workers and caller on one CPU only make progress if waiting threads yield the CPU
+  ASSERT_TRUE(controller_manager::set_thread_affinity({0}));
+  {
+    WorkerPool pool(2, {0});
+    EXPECT_TRUE(pool.is_configured());
+    std::atomic<int> executions{0};
+    auto task = [&](size_t) { ++executions; };
+    for (int run = 0; run < 1000; ++run)
+    {
+      pool.run(3, task);
+    }
+    EXPECT_EQ(3000, executions.load());
+  }
+  std::vector<int> all_cpus(std::max(1u, std::thread::hardware_concurrency()));
+  std::iota(all_cpus.begin(), all_cpus.end(), 0);
+  controller_manager::set_thread_affinity(all_cpus);
+}
@@ -0,0 +1,135 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__COMPONENT_THREAD_POOL_HPP_
+#define HARDWARE_INTERFACE__COMPONENT_THREAD_POOL_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hardware_interface/visibility_control.h"
+
+namespace hardware_interface
+{
+/// Pre-spawned threads, each dedicated to the read() or write() of one hardware component.
+/**
+ * Unlike a work-sharing pool, thread i always executes task i, so a component is accessed from
+ * a single thread only. run() waits for the triggered tasks at most until a timeout passed. A
+ * thread which did not finish in time is left running and is skipped by subsequent runs until
+ * it is idle again, so a hung component does not block the real-time loop.
+ *
+ * Tasks are handed over through atomics without taking any lock, like in the worker pool of the
+ * controller manager. Waiting threads spin for a bounded number of iterations and then block on
+ * a futex, so the real-time caller never waits for a thread holding a lock.
+ */
+class ComponentThreadPool
+{
+public:
+  using Function = std::function<void(size_t)>;
+
+  /// Spawn one thread per task.
+  /**
+   * \param[in] thread_count number of threads, i.e., of tasks executed in each run.
+   * \param[in] cpus CPUs the threads are pinned to, one CPU per thread in round-robin order.
+   * Threads are not pinned if empty.
+   * \param[in] priority SCHED_FIFO priority of the threads, 0 to keep the default policy.
+   */
+  HARDWARE_INTERFACE_PUBLIC
+  explicit ComponentThreadPool(
+    size_t thread_count, const std::vector<int> & cpus = {}, int priority = 0);
+
+  /// Stop all threads, waits for tasks which are still running.
+  HARDWARE_INTERFACE_PUBLIC
+  ~ComponentThreadPool();
+
+  ComponentThreadPool(const ComponentThreadPool &) = delete;
+  ComponentThreadPool & operator=(const ComponentThreadPool &) = delete;
+
+  HARDWARE_INTERFACE_PUBLIC
+  size_t get_thread_count() const;
+
+  /// False if pinning or setting the scheduling policy of a thread failed.
+  HARDWARE_INTERFACE_PUBLIC
+  bool is_configured() const;
+
+  /// Call function(i) on thread i for each idle thread and wait until these calls finished.
+  /**
+   * Neither allocates nor creates threads. Only one thread at a time is allowed to call run().
+   *
+   * \param[in] function task to execute, has to stay valid until all threads are idle, since
+   * calls which timed out may still use it.
+   * \param[in] timeout maximal time to wait for the tasks, zero to wait without limit.
+   * \param[in] prepare if set, called as prepare(i) by the calling thread for each idle thread i
+   * right before its task is triggered.
+   * \return number of threads which are still busy, i.e., whose task timed out in this or in a
+   * previous run.
+   */
+  HARDWARE_INTERFACE_PUBLIC
+  size_t run(
+    const Function & function, std::chrono::nanoseconds timeout, const Function & prepare = {});
+
+  /// True if thread \p index is still executing a task.
+  HARDWARE_INTERFACE_PUBLIC
+  bool is_busy(size_t index) const;
+
+  /// True if the last run() triggered the task of thread \p index, i.e., it was idle.
+  /**
+   * Only to be called by the thread calling run().
+   */
+  HARDWARE_INTERFACE_PUBLIC
+  bool is_triggered(size_t index) const;
+
+private:
+  struct Worker
+  {
+    std::thread thread;
+    /// Incremented for each task and on stop, the thread waits for it to change
+    std::atomic<uint32_t> generation{0};
+    /// Whether the thread is blocked waiting for the next task
+    std::atomic_bool sleeping{false};
+    /// Task to execute next, written before generation is incremented
+    const Function * function = nullptr;
+    std::atomic_bool busy{false};
+    /// Triggered by the current run, only used by the thread calling run()
+    bool triggered = false;
+  };
+
+  void work(Worker & worker, size_t index, const std::vector<int> & cpus, int priority);
+
+  bool triggered_workers_idle() const;
+
+  /// Wait until the triggered workers are idle, at most until \p deadline if \p has_deadline.
+  void wait_for_workers(bool has_deadline, std::chrono::steady_clock::time_point deadline);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  /// Incremented by each worker finishing a task
+  std::atomic<uint32_t> finished_tasks_{0};
+  /// Whether the thread calling run() is blocked waiting for the workers
+  std::atomic_bool caller_sleeping_{false};
+
+  std::atomic_bool stop_{false};
+  std::atomic<size_t> started_workers_{0};
+  std::atomic_bool configured_{true};
+};
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__COMPONENT_THREAD_POOL_HPP_
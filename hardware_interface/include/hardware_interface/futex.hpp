@@ -0,0 +1,57 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__FUTEX_HPP_
+#define HARDWARE_INTERFACE__FUTEX_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "hardware_interface/visibility_control.h"
+
+namespace hardware_interface
+{
+/// Iterations a thread spins before it blocks, a few microseconds on current CPUs
+constexpr int kSpinIterations = 4000;
+
+/// Hint to the CPU that the calling thread is spinning.
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/// Block while \p word has the value \p expected, may return spuriously.
+/**
+ * Threads hand work over by changing the word and waking the waiting threads without taking any
+ * lock, so a real-time thread never waits for a thread of lower priority holding a mutex.
+ *
+ * \param[in] timeout maximal time to block, zero to block without limit.
+ */
+HARDWARE_INTERFACE_PUBLIC
+void futex_wait(
+  std::atomic<uint32_t> & word, uint32_t expected,
+  std::chrono::nanoseconds timeout = std::chrono::nanoseconds::zero());
+
+/// Wake all threads blocked in futex_wait() on \p word.
+HARDWARE_INTERFACE_PUBLIC
+void futex_wake_all(std::atomic<uint32_t> & word);
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__FUTEX_HPP_
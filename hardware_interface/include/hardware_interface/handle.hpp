@@ -15,10 +15,15 @@
 #ifndef HARDWARE_INTERFACE__HANDLE_HPP_
 #define HARDWARE_INTERFACE__HANDLE_HPP_
 
+#include <cstring>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "hardware_interface/macros.hpp"
+#include "hardware_interface/span.hpp"
+#include "hardware_interface/types/handle_data_type.hpp"
 #include "hardware_interface/visibility_control.h"
 
 namespace hardware_interface
@@ -27,19 +32,69 @@ namespace hardware_interface
 class ReadOnlyHandle
 {
 public:
+  /// Handle referencing a double or, if \p size is larger than one, an array of doubles.
   ReadOnlyHandle(
-    const std::string & name, const std::string & interface_name, double * value_ptr = nullptr)
-  : name_(name), interface_name_(interface_name), value_ptr_(value_ptr)
+    const std::string & name, const std::string & interface_name, double * value_ptr = nullptr,
+    size_t size = 1)
+  : name_(name),
+    interface_name_(interface_name),
+    value_ptr_(value_ptr),
+    data_ptr_(value_ptr),
+    data_type_(HandleDataType::DOUBLE),
+    size_(size)
   {
   }
 
+  /// Handle referencing a value of another type than double, e.g., bool or uint8_t.
+  template <typename T, typename = std::enable_if_t<!std::is_same<T, double>::value>>
+  ReadOnlyHandle(const std::string & name, const std::string & interface_name, T * value_ptr)
+  : name_(name),
+    interface_name_(interface_name),
+    value_ptr_(nullptr),
+    data_ptr_(value_ptr),
+    data_type_(HandleDataTypeOf<T>::value),
+    size_(1)
+  {
+  }
+
+  /// Handle referencing \p size values of type \p data_type stored at \p data_ptr.
+  /**
+   * \throws std::runtime_error if \p size is larger than one for another type than double, only
+   * arrays of doubles are supported.
+   */
+  ReadOnlyHandle(
+    const std::string & name, const std::string & interface_name, HandleDataType data_type,
+    void * data_ptr, size_t size = 1)
+  : name_(name),
+    interface_name_(interface_name),
+    value_ptr_(data_type == HandleDataType::DOUBLE ? static_cast<double *>(data_ptr) : nullptr),
+    data_ptr_(data_ptr),
+    data_type_(data_type),
+    size_(size)
+  {
+    if (data_type_ != HandleDataType::DOUBLE && size_ > 1)
+    {
+      throw std::runtime_error(
+        "Interface '" + get_full_name() + "' has data type '" + to_string(data_type_) +
+        "', but only interfaces of doubles can be arrays.");
+    }
+  }
+
   explicit ReadOnlyHandle(const std::string & interface_name)
-  : interface_name_(interface_name), value_ptr_(nullptr)
+  : interface_name_(interface_name),
+    value_ptr_(nullptr),
+    data_ptr_(nullptr),
+    data_type_(HandleDataType::DOUBLE),
+    size_(1)
   {
   }
 
   explicit ReadOnlyHandle(const char * interface_name)
-  : interface_name_(interface_name), value_ptr_(nullptr)
+  : interface_name_(interface_name),
+    value_ptr_(nullptr),
+    data_ptr_(nullptr),
+    data_type_(HandleDataType::DOUBLE),
+    size_(1)
   {
   }
 
@@ -54,7 +109,7 @@ public:
   virtual ~ReadOnlyHandle() = default;
 
   /// Returns true if handle references a value.
-  inline operator bool() const { return value_ptr_ != nullptr; }
+  inline operator bool() const { return data_ptr_ != nullptr; }
 
   const std::string & get_name() const { return name_; }
 
@@ -68,21 +123,79 @@ public:
     return *value_ptr_;
   }
 
+  /// Returns the pointer to the value, nullptr if the handle does not reference a double.
+  const double * get_value_ptr() const { return value_ptr_; }
+
+  HandleDataType get_data_type() const { return data_type_; }
+
+  /// Number of values, larger than one for array interfaces.
+  size_t get_size() const { return size_; }
+
+  /// Returns all values of an array interface of doubles.
+  /**
+   * The view is empty if the handle does not reference doubles.
+   */
+  Span<const double> get_values() const { return Span<const double>(value_ptr_, size_); }
+
+  /// Returns the pointer to the value of any type, nullptr if there is no referenced value.
+  const void * get_data_ptr() const { return data_ptr_; }
+
+  /// Returns the value of an interface of type \p T.
+  /**
+   * \throws std::runtime_error if the interface has another data type or no value.
+   */
+  template <typename T>
+  T get_typed_value() const
+  {
+    check_data_type(HandleDataTypeOf<T>::value);
+    T value;
+    std::memcpy(&value, data_ptr_, sizeof(T));
+    return value;
+  }
+
 protected:
+  void check_data_type(HandleDataType data_type) const
+  {
+    THROW_ON_NULLPTR(data_ptr_);
+    if (data_type != data_type_)
+    {
+      throw std::runtime_error(
+        "Interface '" + get_full_name() + "' has data type '" + to_string(data_type_) +
+        "', not '" + to_string(data_type) + "'.");
+    }
+  }
+
   std::string name_;
   std::string interface_name_;
   double * value_ptr_;
+  void * data_ptr_;
+  HandleDataType data_type_;
+  size_t size_;
 };
 
 class ReadWriteHandle : public ReadOnlyHandle
 {
 public:
   ReadWriteHandle(
-    const std::string & name, const std::string & interface_name, double * value_ptr = nullptr)
+    const std::string & name, const std::string & interface_name, double * value_ptr = nullptr,
+    size_t size = 1)
+  : ReadOnlyHandle(name, interface_name, value_ptr, size)
+  {
+  }
+
+  template <typename T, typename = std::enable_if_t<!std::is_same<T, double>::value>>
+  ReadWriteHandle(const std::string & name, const std::string & interface_name, T * value_ptr)
   : ReadOnlyHandle(name, interface_name, value_ptr)
   {
   }
 
+  ReadWriteHandle(
+    const std::string & name, const std::string & interface_name, HandleDataType data_type,
+    void * data_ptr, size_t size = 1)
+  : ReadOnlyHandle(name, interface_name, data_type, data_ptr, size)
+  {
+  }
+
   explicit ReadWriteHandle(const std::string & interface_name) : ReadOnlyHandle(interface_name) {}
 
   explicit ReadWriteHandle(const char * interface_name) : ReadOnlyHandle(interface_name) {}
@@ -102,6 +215,32 @@ public:
     THROW_ON_NULLPTR(this->value_ptr_);
     *this->value_ptr_ = value;
   }
+
+  using ReadOnlyHandle::get_value_ptr;
+
+  /// Returns the pointer to the value, nullptr if the handle does not reference a double.
+  double * get_value_ptr() { return this->value_ptr_; }
+
+  /// Sets the value of an interface of type \p T.
+  /**
+   * \throws std::runtime_error if the interface has another data type or no value.
+   */
+  template <typename T>
+  void set_typed_value(T value)
+  {
+    this->check_data_type(HandleDataTypeOf<T>::value);
+    std::memcpy(this->data_ptr_, &value, sizeof(T));
+  }
+
+  using ReadOnlyHandle::get_values;
+
+  /// Returns all values of an array interface of doubles, see ReadOnlyHandle::get_values.
+  Span<double> get_values() { return Span<double>(this->value_ptr_, this->size_); }
+
+  using ReadOnlyHandle::get_data_ptr;
+
+  /// Returns the pointer to the value of any type, nullptr if there is no referenced value.
+  void * get_data_ptr() { return this->data_ptr_; }
 };
 
 class StateInterface : public ReadOnlyHandle
@@ -111,6 +250,8 @@ public:
 
   StateInterface(StateInterface && other) = default;
 
+  StateInterface & operator=(StateInterface && other) = default;
+
   using ReadOnlyHandle::ReadOnlyHandle;
 };
 
@@ -127,6 +268,8 @@ public:
 
   CommandInterface(CommandInterface && other) = default;
 
+  CommandInterface & operator=(CommandInterface && other) = default;
+
   using ReadWriteHandle::ReadWriteHandle;
 };
 
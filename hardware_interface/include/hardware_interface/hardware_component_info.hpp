@@ -19,6 +19,8 @@
 #ifndef HARDWARE_INTERFACE__HARDWARE_COMPONENT_INFO_HPP_
 #define HARDWARE_INTERFACE__HARDWARE_COMPONENT_INFO_HPP_
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,6 +29,96 @@
 
 namespace hardware_interface
 {
+/// Execution time statistics of the read or write method of a hardware component.
+struct HardwareComponentExecutionStatistics
+{
+  /// Number of executions.
+  uint64_t count = 0;
+
+  std::chrono::nanoseconds last{0};
+  std::chrono::nanoseconds mean{0};
+  std::chrono::nanoseconds max{0};
+
+  /// Number of cycles in which the method did not finish within the read/write timeout.
+  uint64_t timeout_count = 0;
+
+  /// Number of executions which returned an error.
+  uint64_t error_count = 0;
+};
+
+/// Action taken when read or write of a hardware component failed in consecutive cycles.
+enum class HardwareErrorAction : uint8_t
+{
+  /// Trigger the error transition of the component, which becomes unconfigured or finalized.
+  ERROR_TRANSITION,
+  /// Keep reading and writing the component in every cycle.
+  RETRY,
+  /// Neither read nor write the component for a number of cycles, then retry.
+  SKIP,
+  /// Stop reading and writing the component, and deactivate it with the controllers using it.
+  DEACTIVATE,
+  /// Stop the controllers using interfaces of the component, which keeps being read and written.
+  STOP_CONTROLLERS,
+};
+
+inline std::string to_string(HardwareErrorAction action)
+{
+  switch (action)
+  {
+    case HardwareErrorAction::ERROR_TRANSITION:
+      return "error_transition";
+    case HardwareErrorAction::RETRY:
+      return "retry";
+    case HardwareErrorAction::SKIP:
+      return "skip";
+    case HardwareErrorAction::DEACTIVATE:
+      return "deactivate";
+    case HardwareErrorAction::STOP_CONTROLLERS:
+      return "stop_controllers";
+  }
+  return "unknown";
+}
+
+/// Parse the name of an action as returned by to_string().
+/**
+ * \return false if \p name is not the name of an action.
+ */
+inline bool from_string(const std::string & name, HardwareErrorAction & action)
+{
+  for (auto candidate :
+       {HardwareErrorAction::ERROR_TRANSITION, HardwareErrorAction::RETRY,
+        HardwareErrorAction::SKIP, HardwareErrorAction::DEACTIVATE,
+        HardwareErrorAction::STOP_CONTROLLERS})
+  {
+    if (name == to_string(candidate))
+    {
+      action = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// How the resource manager handles failing read and write of a hardware component.
+/**
+ * A cycle of a component fails if its read or write returns an error or, if
+ * \ref timeouts_fail_cycle is set, exceeds the read/write timeout. The default policy triggers
+ * the error transition in the first failed cycle.
+ */
+struct HardwareErrorPolicy
+{
+  HardwareErrorAction action = HardwareErrorAction::ERROR_TRANSITION;
+
+  /// Number of consecutive failed cycles after which the action is taken, at least 1.
+  unsigned int error_threshold = 1;
+
+  /// Number of cycles the component is not read and written for by HardwareErrorAction::SKIP.
+  unsigned int skip_cycles = 100;
+
+  /// Whether exceeding the read/write timeout fails a cycle, otherwise it is only counted.
+  bool timeouts_fail_cycle = false;
+};
+
 /// Hardware Component Information
 /**
  * This struct contains information about a given hardware component.
@@ -50,6 +142,22 @@ struct HardwareComponentInfo
 
   /// List of provided command interfaces by the component.
   std::vector<std::string> command_interfaces;
+
+  /// Execution time statistics of read, accumulated since the component was loaded.
+  HardwareComponentExecutionStatistics read_statistics;
+
+  /// Execution time statistics of write, accumulated since the component was loaded.
+  HardwareComponentExecutionStatistics write_statistics;
+
+  /// Handling of failing read and write.
+  HardwareErrorPolicy error_policy;
+
+  /// Number of cycles in which read and write were skipped because of the error policy.
+  uint64_t skipped_cycles = 0;
+
+  /// True if read and write are no longer executed because of the error policy, until the
+  /// component is activated again.
+  bool is_halted = false;
 };
 
 }  // namespace hardware_interface
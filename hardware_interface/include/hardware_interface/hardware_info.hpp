@@ -41,7 +41,7 @@ struct InterfaceInfo
   /// (Optional) The datatype of the interface, e.g. "bool", "int". Used by GPIOs.
   std::string data_type;
   /// (Optional) If the handle is an array, the size of the array. Used by GPIOs.
-  int size;
+  int size = 1;
 };
 
 /**
@@ -107,6 +107,10 @@ struct HardwareInfo
   std::string type;
   /// Class of the hardware that will be dynamically loaded.
   std::string hardware_class_type;
+  /// Read and write the hardware in its own thread instead of in the controller manager's loop.
+  bool is_async = false;
+  /// Rate in Hz at which an asynchronous hardware is read and written.
+  unsigned int rw_rate = 0;
   /// (Optional) Key-value pairs for hardware parameters.
   std::unordered_map<std::string, std::string> hardware_parameters;
   /**
@@ -0,0 +1,88 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__INTERFACE_VALUE_ARENA_HPP_
+#define HARDWARE_INTERFACE__INTERFACE_VALUE_ARENA_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace hardware_interface
+{
+/// Contiguous, cache-line aligned storage of interface values.
+/**
+ * Values are allocated in blocks, e.g., all state interfaces of a hardware component, and each
+ * block starts at a cache line, so blocks which are written by different threads never share a
+ * cache line. Allocating may move all values, which invalidates pointers into the arena.
+ */
+class InterfaceValueArena
+{
+public:
+  static constexpr size_t kCacheLineSize = 64;
+  static constexpr size_t kValuesPerCacheLine = kCacheLineSize / sizeof(double);
+
+  /// Allocate \p count consecutive values, initialized to NaN.
+  /**
+   * Not real-time safe.
+   * \return index of the first allocated value.
+   */
+  size_t allocate(size_t count)
+  {
+    const size_t first =
+      (size_ + kValuesPerCacheLine - 1) / kValuesPerCacheLine * kValuesPerCacheLine;
+    size_ = first + count;
+    lines_.resize((size_ + kValuesPerCacheLine - 1) / kValuesPerCacheLine);
+    return first;
+  }
+
+  /// Reserve memory for \p count values allocated in at most \p block_count blocks.
+  /**
+   * Allocations within the reserved memory do not move the values.
+   */
+  void reserve(size_t count, size_t block_count)
+  {
+    lines_.reserve(
+      (size_ + count + kValuesPerCacheLine - 1) / kValuesPerCacheLine + block_count);
+  }
+
+  /// Number of values including the padding between blocks.
+  size_t size() const { return size_; }
+
+  double * data() { return reinterpret_cast<double *>(lines_.data()); }
+
+  const double * data() const { return reinterpret_cast<const double *>(lines_.data()); }
+
+  double & operator[](size_t index) { return data()[index]; }
+
+  const double & operator[](size_t index) const { return data()[index]; }
+
+private:
+  struct alignas(kCacheLineSize) CacheLine
+  {
+    double values[kValuesPerCacheLine] = {
+      std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
+  };
+  static_assert(sizeof(CacheLine) == kCacheLineSize, "values have to fill a cache line");
+
+  std::vector<CacheLine> lines_;
+  size_t size_ = 0;
+};
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__INTERFACE_VALUE_ARENA_HPP_
@@ -15,6 +15,7 @@
 #ifndef HARDWARE_INTERFACE__LOANED_COMMAND_INTERFACE_HPP_
 #define HARDWARE_INTERFACE__LOANED_COMMAND_INTERFACE_HPP_
 
+#include <atomic>
 #include <functional>
 #include <string>
 #include <utility>
@@ -34,16 +35,41 @@ public:
   }
 
   LoanedCommandInterface(CommandInterface & command_interface, Deleter && deleter)
-  : command_interface_(command_interface), deleter_(std::forward<Deleter>(deleter))
+  : command_interface_(command_interface),
+    deleter_(std::forward<Deleter>(deleter)),
+    value_ptr_(command_interface.get_value_ptr())
+  {
+  }
+
+  /// Loan of a claimed command interface, which is released by resetting \p claimed.
+  /**
+   * Used by the resource manager, neither creating nor releasing the loan allocates memory.
+   */
+  LoanedCommandInterface(CommandInterface & command_interface, std::atomic<bool> & claimed)
+  : command_interface_(command_interface),
+    claimed_(&claimed),
+    value_ptr_(command_interface.get_value_ptr())
   {
   }
 
   LoanedCommandInterface(const LoanedCommandInterface & other) = delete;
 
-  LoanedCommandInterface(LoanedCommandInterface && other) = default;
+  LoanedCommandInterface(LoanedCommandInterface && other)
+  : command_interface_(other.command_interface_),
+    deleter_(std::move(other.deleter_)),
+    claimed_(other.claimed_),
+    value_ptr_(other.value_ptr_)
+  {
+    other.deleter_ = nullptr;
+    other.claimed_ = nullptr;
+  }
 
   virtual ~LoanedCommandInterface()
   {
+    if (claimed_)
+    {
+      claimed_->store(false, std::memory_order_release);
+    }
     if (deleter_)
     {
       deleter_();
@@ -60,9 +86,59 @@ public:
 
   double get_value() const { return command_interface_.get_value(); }
 
+  /// Returns true if the loaned interface references a value of type double.
+  /**
+   * The unchecked accessors are only allowed to be called if this is true. Interfaces of other
+   * types reference their value through the handle only, see has_data().
+   */
+  bool has_value() const { return value_ptr_ != nullptr; }
+
+  /// Returns true if the loaned interface references a value of any type.
+  bool has_data() const { return static_cast<bool>(command_interface_); }
+
+  HandleDataType get_data_type() const { return command_interface_.get_data_type(); }
+
+  /// Number of values, larger than one for array interfaces.
+  size_t get_size() const { return command_interface_.get_size(); }
+
+  /// Returns all values of an array interface, see ReadWriteHandle::get_values.
+  Span<double> get_values() { return command_interface_.get_values(); }
+
+  Span<const double> get_values() const
+  {
+    return static_cast<const CommandInterface &>(command_interface_).get_values();
+  }
+
+  /// Returns the value of an interface of type \p T, see ReadOnlyHandle::get_typed_value.
+  template <typename T>
+  T get_typed_value() const
+  {
+    return command_interface_.get_typed_value<T>();
+  }
+
+  /// Sets the value of an interface of type \p T, see ReadWriteHandle::set_typed_value.
+  template <typename T>
+  void set_typed_value(T value)
+  {
+    command_interface_.set_typed_value<T>(value);
+  }
+
+  /// Real-time accessors of the value without any checks.
+  /**
+   * The pointer to the value is resolved when the interface is loaned, so these only read or
+   * write the value. Only call them if has_value() is true, which
+   * ControllerInterface::assign_interfaces checks for all loaned interfaces of a controller, and
+   * the interface is of type double.
+   */
+  void set_value_unchecked(double val) { *value_ptr_ = val; }
+
+  double get_value_unchecked() const { return *value_ptr_; }
+
 protected:
   CommandInterface & command_interface_;
   Deleter deleter_;
+  std::atomic<bool> * claimed_ = nullptr;
+  double * value_ptr_;
 };
 
 }  // namespace hardware_interface
@@ -34,7 +34,9 @@ public:
   }
 
   LoanedStateInterface(StateInterface & state_interface, Deleter && deleter)
-  : state_interface_(state_interface), deleter_(std::forward<Deleter>(deleter))
+  : state_interface_(state_interface),
+    deleter_(std::forward<Deleter>(deleter)),
+    value_ptr_(state_interface.get_value_ptr())
   {
   }
 
@@ -58,9 +60,43 @@ public:
 
   double get_value() const { return state_interface_.get_value(); }
 
+  /// Returns true if the loaned interface references a value of type double.
+  /**
+   * The unchecked accessors are only allowed to be called if this is true. Interfaces of other
+   * types reference their value through the handle only, see has_data().
+   */
+  bool has_value() const { return value_ptr_ != nullptr; }
+
+  /// Returns true if the loaned interface references a value of any type.
+  bool has_data() const { return static_cast<bool>(state_interface_); }
+
+  HandleDataType get_data_type() const { return state_interface_.get_data_type(); }
+
+  /// Number of values, larger than one for array interfaces.
+  size_t get_size() const { return state_interface_.get_size(); }
+
+  /// Returns all values of an array interface, see ReadOnlyHandle::get_values.
+  Span<const double> get_values() const { return state_interface_.get_values(); }
+
+  /// Returns the value of an interface of type \p T, see ReadOnlyHandle::get_typed_value.
+  template <typename T>
+  T get_typed_value() const
+  {
+    return state_interface_.get_typed_value<T>();
+  }
+
+  /// Real-time accessor of the value without any checks.
+  /**
+   * The pointer to the value is resolved when the interface is loaned, so this only reads the
+   * value. Only call it if has_value() is true, which ControllerInterface::assign_interfaces
+   * checks for all loaned interfaces of a controller, and the interface is of type double.
+   */
+  double get_value_unchecked() const { return *value_ptr_; }
+
 protected:
   StateInterface & state_interface_;
   Deleter deleter_;
+  const double * value_ptr_;
 };
 
 }  // namespace hardware_interface
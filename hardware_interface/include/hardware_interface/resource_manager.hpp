@@ -15,6 +15,8 @@
 #ifndef HARDWARE_INTERFACE__RESOURCE_MANAGER_HPP_
 #define HARDWARE_INTERFACE__RESOURCE_MANAGER_HPP_
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -25,6 +27,7 @@
 #include "hardware_interface/hardware_info.hpp"
 #include "hardware_interface/loaned_command_interface.hpp"
 #include "hardware_interface/loaned_state_interface.hpp"
+#include "hardware_interface/state_snapshot.hpp"
 #include "hardware_interface/types/hardware_interface_return_values.hpp"
 
 namespace hardware_interface
@@ -86,6 +89,16 @@ public:
    */
   LoanedStateInterface claim_state_interface(const std::string & key);
 
+  /// Claim multiple state interfaces at once.
+  /**
+   * Either all interfaces are claimed or none of them.
+   *
+   * \param[in] keys String identifiers of the state interfaces to claim
+   * \return state interfaces in the order of \p keys
+   * \throws std::runtime_error if any of the interfaces is not available.
+   */
+  std::vector<LoanedStateInterface> claim_state_interfaces(const std::vector<std::string> & keys);
+
   /// Returns all registered state interfaces keys.
   /**
    * The keys are collected from each loaded hardware component.
@@ -134,6 +147,19 @@ public:
    */
   LoanedCommandInterface claim_command_interface(const std::string & key);
 
+  /// Claim multiple command interfaces at once, e.g., all interfaces of a controller.
+  /**
+   * The interfaces are checked and claimed under a single lock, so either all interfaces are
+   * claimed or none of them.
+   *
+   * \param[in] keys String identifiers of the command interfaces to claim
+   * \return command interfaces in the order of \p keys
+   * \throws std::runtime_error if any of the interfaces is not available, already claimed or
+   * contained multiple times in \p keys.
+   */
+  std::vector<LoanedCommandInterface> claim_command_interfaces(
+    const std::vector<std::string> & keys);
+
   /// Returns all registered command interfaces keys.
   /**
    * The keys are collected from each loaded hardware component.
@@ -260,6 +286,8 @@ public:
    * \note this is intended for mode-switching when a hardware interface needs to change
    * control mode depending on which command interface is claimed.
    * \note this is for realtime switching of the command interface.
+   * \note asynchronous components perform the switch prepared last in their own thread, their
+   * failures are not returned, is_command_mode_switch_done() does not report the switch as done.
    * \param[in] start_interfaces vector of string identifiers for the command interfaces starting.
    * \param[in] stop_interfaces vector of string identifiers for the command interfacs stopping.
    * \return true if switch is performed, false if a component rejects switching.
@@ -268,6 +296,15 @@ public:
     const std::vector<std::string> & start_interfaces,
     const std::vector<std::string> & stop_interfaces);
 
+  /// Check whether the hardware components completed the mode switching of command interfaces.
+  /**
+   * \note this is for realtime use, it is called by the update loop after
+   * perform_command_mode_switch() until it returns true.
+   * \param[in] interfaces vector of string identifiers for the command interfaces started.
+   * \return true if no component is still switching the mode of any of the interfaces.
+   */
+  bool is_command_mode_switch_done(const std::vector<std::string> & interfaces);
+
   /// Sets state of hardware component.
   /**
    * Set set of hardware component if possible.
@@ -284,9 +321,65 @@ public:
   return_type set_component_state(
     const std::string & component_name, rclcpp_lifecycle::State & target_state);
 
+  /// Execute read and write of each hardware component in a dedicated thread.
+  /**
+   * read() and write() then trigger the threads of all components and wait until they finished
+   * or the read/write timeout passed. A component whose read or write did not finish in time is
+   * skipped in the following cycles until it finished; its values may change while controllers
+   * are updated in the meantime.
+   *
+   * The method is not part of the real-time critical update loop and has to be called once,
+   * after all hardware components are loaded. Components loaded later are read and written by
+   * the thread calling read() and write().
+   *
+   * \param[in] cpus CPUs the threads are pinned to, one CPU per component in round-robin order.
+   * Threads are not pinned if empty.
+   * \param[in] priority SCHED_FIFO priority of the threads, 0 to keep the default policy.
+   * \return false if parallel read and write was already enabled, or if pinning or setting the
+   * scheduling policy of a thread failed, the threads are used nonetheless in the latter case.
+   */
+  bool enable_parallel_read_write(const std::vector<int> & cpus = {}, int priority = 0);
+
+  /// Set the time read or write of a single hardware component may take.
+  /**
+   * Cycles in which a component exceeds the timeout are counted in the execution statistics
+   * reported by get_components_status(). If read and write are executed in parallel, the update
+   * loop waits for a component at most until the timeout passed.
+   *
+   * \param[in] timeout maximal execution time, zero disables the timeout.
+   */
+  void set_read_write_timeout(std::chrono::nanoseconds timeout);
+
+  /// Set how failing read and write of a hardware component are handled.
+  /**
+   * Cycles in which read or write of the component return an error or exceed the read/write
+   * timeout count as failed. The update loop takes the action of the policy itself, except for
+   * the parts of HardwareErrorAction::DEACTIVATE and HardwareErrorAction::STOP_CONTROLLERS which
+   * are not real-time safe: these components are reported by take_failed_components().
+   *
+   * The method is not part of the real-time critical update loop.
+   *
+   * \param[in] component_name name of the hardware component.
+   * \param[in] policy error policy, an error threshold of 0 is treated as 1.
+   * \return false if the component does not exist.
+   */
+  bool set_error_policy(const std::string & component_name, const HardwareErrorPolicy & policy);
+
+  /// Return the components whose error policy asked for deactivation or stopping controllers.
+  /**
+   * Each component is returned once per triggered action. The caller is expected to stop the
+   * controllers using interfaces of the components and to deactivate the components whose action
+   * is HardwareErrorAction::DEACTIVATE; these components are no longer read and written until
+   * they are activated again.
+   *
+   * The method is not part of the real-time critical update loop.
+   */
+  std::vector<std::string> take_failed_components();
+
   /// Reads all loaded hardware components.
   /**
-   * Reads from all active hardware components.
+   * Reads from all active hardware components. Errors are handled according to the error policy
+   * of each component, see set_error_policy().
    *
    * Part of the real-time critical update loop.
    * It is realtime-safe if used hadware interfaces are implemented adequately.
@@ -295,13 +388,58 @@ public:
 
   /// Write all loaded hardware components.
   /**
-   * Writes to all active hardware components.
+   * Writes to all active hardware components. Errors are handled according to the error policy
+   * of each component, see set_error_policy().
    *
    * Part of the real-time critical update loop.
    * It is realtime-safe if used hadware interfaces are implemented adequately.
    */
   void write();
 
+  /// Publish a snapshot of all interface values at the end of each read().
+  /**
+   * The snapshots are published to a lock-free ring of \p capacity snapshots, which is read by
+   * consume_state_snapshot(). read() never waits for the consumer; if the ring is full, the
+   * snapshot of the cycle is dropped.
+   *
+   * The method is not part of the real-time critical update loop and has to be called after
+   * all hardware components are loaded, the values of components loaded later are not part of
+   * the snapshots. As read() and consume_state_snapshot() access the ring without locking, it
+   * can only be called before the update loop starts, i.e. before the first read(), and not
+   * while snapshots are consumed.
+   *
+   * \param[in] capacity number of snapshots the ring holds, 0 disables the snapshots.
+   * \throws std::runtime_error if read() was called before.
+   */
+  void enable_state_snapshots(size_t capacity);
+
+  /// Where the values of each interface are in the snapshots.
+  StateSnapshotLayout get_state_snapshot_layout() const;
+
+  /// Pass the oldest snapshot which was not consumed yet to \p consumer without copying it.
+  /**
+   * The method is not part of the real-time critical update loop. Snapshots have to be consumed
+   * by a single thread.
+   *
+   * \return false if there is no snapshot to consume.
+   */
+  bool consume_state_snapshot(const std::function<void(const StateSnapshot &)> & consumer);
+
+  /// Number of values of all interfaces, including padding between the values of components.
+  size_t get_interface_value_count() const;
+
+  /// Where the values of each interface are in the values returned by get_interface_values().
+  StateSnapshotLayout get_interface_value_layout() const;
+
+  /// Values of all interfaces, to be read by the real-time critical update loop only.
+  /**
+   * The values move when components are imported, the pointer has to be taken again in each
+   * cycle. The layout of the values imported before stays the same.
+   *
+   * \return get_interface_value_count() values.
+   */
+  const double * get_interface_values() const;
+
   /// Activates all available hardware components in the system.
   /**
    * All available hardware components int the ros2_control framework are activated.
@@ -313,8 +451,6 @@ public:
 private:
   void validate_storage(const std::vector<hardware_interface::HardwareInfo> & hardware_info) const;
 
-  void release_command_interface(const std::string & key);
-
   std::unordered_map<std::string, bool> claimed_command_interface_map_;
 
   mutable std::recursive_mutex resource_interfaces_lock_;
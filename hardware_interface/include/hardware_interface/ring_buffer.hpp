@@ -0,0 +1,98 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__RING_BUFFER_HPP_
+#define HARDWARE_INTERFACE__RING_BUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace hardware_interface
+{
+/// Lock-free queue of values between one writing and one reading thread.
+/**
+ * The writer fills the back slot and publishes it, the reader takes the published slots in
+ * order. Neither side ever blocks or waits for the other one; if the reader did not take any of
+ * the published slots yet, the ring is full and the writer has to drop its value.
+ * No method allocates, so T should be preallocated by the initial value, e.g., a vector which
+ * is only assigned values of the same size.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+  explicit RingBuffer(size_t capacity, const T & initial_value = T())
+  : slots_(capacity + 1, initial_value)
+  {
+  }
+
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer & operator=(const RingBuffer &) = delete;
+
+  /// Slot to be filled by the writer, publish() makes it available to the reader.
+  /**
+   * \return nullptr if the ring is full.
+   */
+  T * back()
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (next(head) == tail_.load(std::memory_order_acquire))
+    {
+      return nullptr;
+    }
+    return &slots_[head];
+  }
+
+  /// Make the slot returned by back() available to the reader.
+  void publish()
+  {
+    head_.store(next(head_.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  /// Oldest slot published and not yet taken by the reader.
+  /**
+   * \return nullptr if the ring is empty.
+   */
+  const T * front() const
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire))
+    {
+      return nullptr;
+    }
+    return &slots_[tail];
+  }
+
+  /// Give the slot returned by front() back to the writer.
+  void pop()
+  {
+    tail_.store(next(tail_.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  size_t capacity() const { return slots_.size() - 1; }
+
+private:
+  size_t next(size_t index) const { return index + 1 == slots_.size() ? 0 : index + 1; }
+
+  std::vector<T> slots_;
+  /// Next slot of the writer, written only by the writer
+  alignas(64) std::atomic<size_t> head_{0};
+  /// Next slot of the reader, written only by the reader
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__RING_BUFFER_HPP_
@@ -72,8 +72,9 @@ public:
   HARDWARE_INTERFACE_PUBLIC
   const rclcpp_lifecycle::State & get_state() const;
 
+  /// Read the component, triggering the error transition if it fails and \p handle_error.
   HARDWARE_INTERFACE_PUBLIC
-  return_type read();
+  return_type read(bool handle_error = true);
 
 private:
   std::unique_ptr<SensorInterface> impl_;
@@ -0,0 +1,53 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__SPAN_HPP_
+#define HARDWARE_INTERFACE__SPAN_HPP_
+
+#include <cstddef>
+
+namespace hardware_interface
+{
+/// View of contiguous values owned by someone else, e.g., the values of an array interface.
+/**
+ * A minimal replacement of C++20's std::span.
+ */
+template <typename T>
+class Span
+{
+public:
+  Span() = default;
+
+  Span(T * data, size_t size) : data_(data), size_(data ? size : 0) {}
+
+  T * data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  T & operator[](size_t index) const { return data_[index]; }
+
+  T * begin() const { return data_; }
+
+  T * end() const { return data_ + size_; }
+
+private:
+  T * data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__SPAN_HPP_
@@ -0,0 +1,63 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__STATE_SNAPSHOT_HPP_
+#define HARDWARE_INTERFACE__STATE_SNAPSHOT_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hardware_interface/types/handle_data_type.hpp"
+
+namespace hardware_interface
+{
+/// Values of all interfaces of the resource manager at the end of one read().
+struct StateSnapshot
+{
+  /// Number of the read() the snapshot was taken at, gaps mean that snapshots were dropped.
+  uint64_t version = 0;
+  /// Time the snapshot was taken at.
+  std::chrono::steady_clock::time_point stamp;
+  /// Values of all interfaces, see StateSnapshotLayout for where the values of an interface are.
+  /**
+   * Command values are the ones of the last write().
+   */
+  std::vector<double> values;
+};
+
+/// Where the values of an interface are in a StateSnapshot.
+struct SnapshotInterfaceInfo
+{
+  /// Full name of the interface, e.g., "joint1/position".
+  std::string name;
+  /// Index of the first value in StateSnapshot::values.
+  size_t index = 0;
+  /// Number of values, larger than one for array interfaces.
+  size_t size = 1;
+  /// Data type of the values, whose bytes are stored at the start of each double.
+  HandleDataType data_type = HandleDataType::DOUBLE;
+};
+
+/// Where the values of all interfaces are in a StateSnapshot.
+struct StateSnapshotLayout
+{
+  std::vector<SnapshotInterfaceInfo> state_interfaces;
+  std::vector<SnapshotInterfaceInfo> command_interfaces;
+};
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__STATE_SNAPSHOT_HPP_
@@ -77,17 +77,22 @@ public:
     const std::vector<std::string> & start_interfaces,
     const std::vector<std::string> & stop_interfaces);
 
+  HARDWARE_INTERFACE_PUBLIC
+  bool is_command_mode_switch_done(const std::vector<std::string> & interfaces);
+
   HARDWARE_INTERFACE_PUBLIC
   std::string get_name() const;
 
   HARDWARE_INTERFACE_PUBLIC
   const rclcpp_lifecycle::State & get_state() const;
 
+  /// Read the component, triggering the error transition if it fails and \p handle_error.
   HARDWARE_INTERFACE_PUBLIC
-  return_type read();
+  return_type read(bool handle_error = true);
 
+  /// Write the component, triggering the error transition if it fails and \p handle_error.
   HARDWARE_INTERFACE_PUBLIC
-  return_type write();
+  return_type write(bool handle_error = true);
 
 private:
   std::unique_ptr<SystemInterface> impl_;
@@ -158,6 +158,24 @@ public:
     return return_type::OK;
   }
 
+  /// Check whether the mode-switching of command interfaces is completed.
+  /**
+   * Hardware which needs some time to switch the mode of a command interface, e.g., because the
+   * drive has to acknowledge the new mode, reports here when the switch performed by
+   * perform_command_mode_switch() is completed. The controllers using the interfaces are not
+   * updated before.
+   *
+   * \note This is part of the realtime update loop, and should be fast.
+   * \note All interface keys are passed to all components, so the function should return true
+   * for interface keys not relevant for this system.
+   * \param[in] interfaces vector of string identifiers of started command interfaces.
+   * \return false if the mode-switching of any of the interfaces is not completed yet.
+   */
+  virtual bool is_command_mode_switch_done(const std::vector<std::string> & /*interfaces*/)
+  {
+    return true;
+  }
+
   /// Read the current state values from the actuator.
   /**
    * The data readings from the physical hardware has to be updated
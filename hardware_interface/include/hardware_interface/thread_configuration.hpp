@@ -0,0 +1,42 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__THREAD_CONFIGURATION_HPP_
+#define HARDWARE_INTERFACE__THREAD_CONFIGURATION_HPP_
+
+#include <vector>
+
+#include "hardware_interface/visibility_control.h"
+
+namespace hardware_interface
+{
+/// Switch the calling thread to the SCHED_FIFO real-time scheduling policy.
+/**
+ * \param[in] priority SCHED_FIFO priority, between 1 and 99.
+ * \return true on success, false otherwise with errno set to the reason of the failure.
+ */
+HARDWARE_INTERFACE_PUBLIC
+bool configure_sched_fifo(int priority);
+
+/// Pin the calling thread to the given set of CPUs.
+/**
+ * \param[in] cpus indices of the CPUs the thread is allowed to run on.
+ * \return true on success, false otherwise with errno set to the reason of the failure.
+ */
+HARDWARE_INTERFACE_PUBLIC
+bool set_thread_affinity(const std::vector<int> & cpus);
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__THREAD_CONFIGURATION_HPP_
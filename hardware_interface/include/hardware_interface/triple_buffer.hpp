@@ -0,0 +1,85 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__TRIPLE_BUFFER_HPP_
+#define HARDWARE_INTERFACE__TRIPLE_BUFFER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace hardware_interface
+{
+/// Lock-free exchange of the latest value between one writing and one reading thread.
+/**
+ * The writer fills the back buffer and publishes it, the reader fetches the most recently
+ * published buffer. Neither side ever blocks or waits for the other one, and values published
+ * in between two fetches are overwritten, i.e., the reader always gets the latest value.
+ * No method allocates, so T should be preallocated by the initial value, e.g., a vector which
+ * is only assigned values of the same size.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+  explicit TripleBuffer(const T & initial_value = T())
+  : buffers_{{initial_value, initial_value, initial_value}}
+  {
+  }
+
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer & operator=(const TripleBuffer &) = delete;
+
+  /// Buffer to be filled by the writer, publish() makes it available to the reader.
+  T & back() { return buffers_[back_]; }
+
+  /// Make the back buffer available to the reader, the writer gets a new back buffer.
+  void publish()
+  {
+    back_ = middle_.exchange(back_ | kNewDataFlag, std::memory_order_acq_rel) & kIndexMask;
+  }
+
+  /// Fetch the most recently published buffer.
+  /**
+   * \return true if a buffer was published since the last fetch, otherwise front() is unchanged.
+   */
+  bool fetch()
+  {
+    if (!(middle_.load(std::memory_order_relaxed) & kNewDataFlag))
+    {
+      return false;
+    }
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+    return true;
+  }
+
+  /// Buffer last fetched by the reader.
+  const T & front() const { return buffers_[front_]; }
+
+private:
+  static constexpr uint8_t kIndexMask = 0x3;
+  static constexpr uint8_t kNewDataFlag = 0x4;
+
+  std::array<T, 3> buffers_;
+  /// Index of the buffer shared between writer and reader, flagged if not fetched yet
+  std::atomic<uint8_t> middle_{1};
+  /// Only accessed by the writer
+  uint8_t back_ = 0;
+  /// Only accessed by the reader
+  uint8_t front_ = 2;
+};
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__TRIPLE_BUFFER_HPP_
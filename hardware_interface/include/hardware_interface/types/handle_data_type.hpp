@@ -0,0 +1,150 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HARDWARE_INTERFACE__TYPES__HANDLE_DATA_TYPE_HPP_
+#define HARDWARE_INTERFACE__TYPES__HANDLE_DATA_TYPE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace hardware_interface
+{
+/// Data type of the value referenced by a handle.
+/**
+ * All types fit into the storage of a double, so the resource manager can store values of every
+ * type in the same slots.
+ */
+enum class HandleDataType : uint8_t
+{
+  DOUBLE,
+  BOOL,
+  INT8,
+  UINT8,
+  INT16,
+  UINT16,
+  INT32,
+  UINT32,
+  INT64,
+  UINT64,
+};
+
+/// Maps a C++ type to its HandleDataType, undefined for unsupported types.
+template <typename T>
+struct HandleDataTypeOf;
+
+#define HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(type, data_type)        \
+  template <>                                                          \
+  struct HandleDataTypeOf<type>                                        \
+  {                                                                    \
+    static constexpr HandleDataType value = HandleDataType::data_type; \
+  };
+
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(double, DOUBLE)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(bool, BOOL)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(int8_t, INT8)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(uint8_t, UINT8)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(int16_t, INT16)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(uint16_t, UINT16)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(int32_t, INT32)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(uint32_t, UINT32)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(int64_t, INT64)
+HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF(uint64_t, UINT64)
+
+#undef HARDWARE_INTERFACE_HANDLE_DATA_TYPE_OF
+
+/// Size of a value of type \p data_type in bytes.
+inline size_t get_size(HandleDataType data_type)
+{
+  switch (data_type)
+  {
+    case HandleDataType::BOOL:
+      return sizeof(bool);
+    case HandleDataType::INT8:
+    case HandleDataType::UINT8:
+      return sizeof(uint8_t);
+    case HandleDataType::INT16:
+    case HandleDataType::UINT16:
+      return sizeof(uint16_t);
+    case HandleDataType::INT32:
+    case HandleDataType::UINT32:
+      return sizeof(uint32_t);
+    case HandleDataType::INT64:
+    case HandleDataType::UINT64:
+      return sizeof(uint64_t);
+    case HandleDataType::DOUBLE:
+    default:
+      return sizeof(double);
+  }
+}
+
+/// Name of \p data_type as used for the `data_type` attribute in the URDF.
+inline std::string to_string(HandleDataType data_type)
+{
+  switch (data_type)
+  {
+    case HandleDataType::BOOL:
+      return "bool";
+    case HandleDataType::INT8:
+      return "int8";
+    case HandleDataType::UINT8:
+      return "uint8";
+    case HandleDataType::INT16:
+      return "int16";
+    case HandleDataType::UINT16:
+      return "uint16";
+    case HandleDataType::INT32:
+      return "int32";
+    case HandleDataType::UINT32:
+      return "uint32";
+    case HandleDataType::INT64:
+      return "int64";
+    case HandleDataType::UINT64:
+      return "uint64";
+    case HandleDataType::DOUBLE:
+    default:
+      return "double";
+  }
+}
+
+/// Parse the `data_type` attribute of an interface in the URDF.
+/**
+ * An empty string is parsed as double and "int" as int32.
+ * \return false if \p name is not a data type of handles, e.g., a complex type used by a GPIO.
+ */
+inline bool from_string(const std::string & name, HandleDataType & data_type)
+{
+  static const std::pair<const char *, HandleDataType> names[] = {
+    {"", HandleDataType::DOUBLE},       {"double", HandleDataType::DOUBLE},
+    {"bool", HandleDataType::BOOL},     {"int8", HandleDataType::INT8},
+    {"uint8", HandleDataType::UINT8},   {"int16", HandleDataType::INT16},
+    {"uint16", HandleDataType::UINT16}, {"int", HandleDataType::INT32},
+    {"int32", HandleDataType::INT32},   {"uint32", HandleDataType::UINT32},
+    {"int64", HandleDataType::INT64},   {"uint64", HandleDataType::UINT64},
+  };
+  for (const auto & entry : names)
+  {
+    if (name == entry.first)
+    {
+      data_type = entry.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace hardware_interface
+
+#endif  // HARDWARE_INTERFACE__TYPES__HANDLE_DATA_TYPE_HPP_
@@ -212,11 +212,16 @@ return_type Actuator::perform_command_mode_switch(
   return impl_->perform_command_mode_switch(start_interfaces, stop_interfaces);
 }
 
+bool Actuator::is_command_mode_switch_done(const std::vector<std::string> & interfaces)
+{
+  return impl_->is_command_mode_switch_done(interfaces);
+}
+
 std::string Actuator::get_name() const { return impl_->get_name(); }
 
 const rclcpp_lifecycle::State & Actuator::get_state() const { return impl_->get_state(); }
 
-return_type Actuator::read()
+return_type Actuator::read(bool handle_error)
 {
   return_type result = return_type::ERROR;
   if (
@@ -224,7 +229,7 @@ return_type Actuator::read()
     impl_->get_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
   {
     result = impl_->read();
-    if (result == return_type::ERROR)
+    if (result == return_type::ERROR && handle_error)
     {
       error();
     }
@@ -232,7 +237,7 @@ return_type Actuator::read()
   return result;
 }
 
-return_type Actuator::write()
+return_type Actuator::write(bool handle_error)
 {
   return_type result = return_type::ERROR;
   if (
@@ -240,7 +245,7 @@ return_type Actuator::write()
     impl_->get_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
   {
     result = impl_->write();
-    if (result == return_type::ERROR)
+    if (result == return_type::ERROR && handle_error)
     {
       error();
     }
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <tinyxml2.h>
+#include <cstdint>
+#include <limits>
 #include <regex>
 #include <stdexcept>
 #include <string>
@@ -46,6 +48,8 @@ constexpr const auto kTypeAttribute = "type";
 constexpr const auto kRoleAttribute = "role";
 constexpr const auto kReductionAttribute = "mechanical_reduction";
 constexpr const auto kOffsetAttribute = "offset";
+constexpr const auto kIsAsyncAttribute = "is_async";
+constexpr const auto kRWRateAttribute = "rw_rate";
 }  // namespace
 
 namespace hardware_interface
@@ -206,6 +210,65 @@ std::string parse_data_type_attribute(const tinyxml2::XMLElement * elem)
   return data_type;
 }
 
+/// Parse is_async and rw_rate attributes
+/**
+ * Parses the ros2_control tag of a hardware for the is_async attribute, which defaults to false,
+ * and the rw_rate attribute, which is required for asynchronous hardware.
+ *
+ * \param[in] ros2_control_it XMLElement of the ros2_control tag.
+ * \param[out] hardware HardwareInfo whose is_async and rw_rate fields are set.
+ * \throws std::runtime_error if is_async is not a boolean or if rw_rate is not given a positive
+ * non-zero integer for asynchronous hardware.
+ */
+void parse_async_attributes(const tinyxml2::XMLElement * ros2_control_it, HardwareInfo & hardware)
+{
+  const tinyxml2::XMLAttribute * async_attr = ros2_control_it->FindAttribute(kIsAsyncAttribute);
+  if (!async_attr)
+  {
+    return;
+  }
+  const std::string is_async = async_attr->Value();
+  if (is_async == "true" || is_async == "True")
+  {
+    hardware.is_async = true;
+  }
+  else if (is_async != "false" && is_async != "False")
+  {
+    throw std::runtime_error(
+      "Could not parse " + std::string(kIsAsyncAttribute) + " attribute of hardware '" +
+      hardware.name + "'. Got \"" + is_async + "\", but expected \"true\" or \"false\".");
+  }
+  if (!hardware.is_async)
+  {
+    return;
+  }
+
+  const tinyxml2::XMLAttribute * rate_attr = ros2_control_it->FindAttribute(kRWRateAttribute);
+  const std::string rate = rate_attr ? rate_attr->Value() : "";
+  std::regex int_re("[1-9][0-9]*");
+  // rates which do not fit into an unsigned int are rejected like any other bad rate
+  uint64_t parsed_rate = 0;
+  if (std::regex_match(rate, int_re))
+  {
+    try
+    {
+      parsed_rate = std::stoul(rate);
+    }
+    catch (const std::out_of_range &)
+    {
+      parsed_rate = 0;
+    }
+  }
+  if (parsed_rate == 0 || parsed_rate > std::numeric_limits<unsigned int>::max())
+  {
+    throw std::runtime_error(
+      "Could not parse " + std::string(kRWRateAttribute) + " attribute of asynchronous hardware '" +
+      hardware.name + "'. Got \"" + rate + "\", but expected a non-zero positive integer of at " +
+      "most " + std::to_string(std::numeric_limits<unsigned int>::max()) + ".");
+  }
+  hardware.rw_rate = static_cast<unsigned int>(parsed_rate);
+}
+
 /// Search XML snippet from URDF for parameters.
 /**
  * \param[in] params_it pointer to the iterator where parameters info should be found
@@ -491,6 +554,7 @@ HardwareInfo parse_resource_from_xml(const tinyxml2::XMLElement * ros2_control_i
   HardwareInfo hardware;
   hardware.name = get_attribute_value(ros2_control_it, kNameAttribute, kROS2ControlTag);
   hardware.type = get_attribute_value(ros2_control_it, kTypeAttribute, kROS2ControlTag);
+  parse_async_attributes(ros2_control_it, hardware);
 
   // Parse everything under ros2_control tag
   hardware.hardware_class_type = "";
@@ -0,0 +1,205 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hardware_interface/component_thread_pool.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hardware_interface/futex.hpp"
+#include "hardware_interface/thread_configuration.hpp"
+
+namespace hardware_interface
+{
+ComponentThreadPool::ComponentThreadPool(
+  size_t thread_count, const std::vector<int> & cpus, int priority)
+{
+  workers_.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
+  {
+    workers_.emplace_back(std::make_unique<Worker>());
+  }
+  for (size_t i = 0; i < thread_count; ++i)
+  {
+    workers_[i]->thread =
+      std::thread(&ComponentThreadPool::work, this, std::ref(*workers_[i]), i, cpus, priority);
+  }
+  // wait until all threads are configured
+  while (started_workers_.load() < thread_count)
+  {
+    std::this_thread::yield();
+  }
+}
+
+ComponentThreadPool::~ComponentThreadPool()
+{
+  stop_ = true;
+  for (auto & worker : workers_)
+  {
+    worker->generation.fetch_add(1);
+    futex_wake_all(worker->generation);
+  }
+  for (auto & worker : workers_)
+  {
+    worker->thread.join();
+  }
+}
+
+size_t ComponentThreadPool::get_thread_count() const { return workers_.size(); }
+
+bool ComponentThreadPool::is_configured() const { return configured_.load(); }
+
+bool ComponentThreadPool::is_busy(size_t index) const { return workers_[index]->busy.load(); }
+
+bool ComponentThreadPool::is_triggered(size_t index) const { return workers_[index]->triggered; }
+
+size_t ComponentThreadPool::run(
+  const Function & function, std::chrono::nanoseconds timeout, const Function & prepare)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  for (size_t i = 0; i < workers_.size(); ++i)
+  {
+    auto & worker = workers_[i];
+    // a thread which is still busy timed out in a previous run, do not wait for it again
+    worker->triggered = !worker->busy.load();
+    if (worker->triggered)
+    {
+      if (prepare)
+      {
+        prepare(i);
+      }
+      // the worker is idle, it reads the task only after the new generation was published
+      worker->busy = true;
+      worker->function = &function;
+      worker->generation.fetch_add(1);
+      if (worker->sleeping.load())
+      {
+        futex_wake_all(worker->generation);
+      }
+    }
+  }
+
+  wait_for_workers(timeout > std::chrono::nanoseconds::zero(), deadline);
+
+  size_t busy_count = 0;
+  for (const auto & worker : workers_)
+  {
+    if (worker->busy.load())
+    {
+      ++busy_count;
+    }
+  }
+  return busy_count;
+}
+
+void ComponentThreadPool::wait_for_workers(
+  bool has_deadline, std::chrono::steady_clock::time_point deadline)
+{
+  for (int i = 0; i < kSpinIterations; ++i)
+  {
+    if (triggered_workers_idle())
+    {
+      return;
+    }
+    cpu_relax();
+  }
+  while (true)
+  {
+    // a worker finishing after the flag is set sees it and wakes this thread up
+    caller_sleeping_.store(true);
+    const uint32_t finished = finished_tasks_.load();
+    if (triggered_workers_idle())
+    {
+      break;
+    }
+    auto remaining = std::chrono::nanoseconds::zero();
+    if (has_deadline)
+    {
+      remaining = deadline - std::chrono::steady_clock::now();
+      if (remaining <= std::chrono::nanoseconds::zero())
+      {
+        break;
+      }
+    }
+    futex_wait(finished_tasks_, finished, remaining);
+  }
+  caller_sleeping_.store(false);
+}
+
+bool ComponentThreadPool::triggered_workers_idle() const
+{
+  for (const auto & worker : workers_)
+  {
+    if (worker->triggered && worker->busy.load())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ComponentThreadPool::work(
+  Worker & worker, size_t index, const std::vector<int> & cpus, int priority)
+{
+  if (!cpus.empty() && !set_thread_affinity({cpus[index % cpus.size()]}))
+  {
+    configured_ = false;
+  }
+  if (priority > 0 && !configure_sched_fifo(priority))
+  {
+    configured_ = false;
+  }
+
+  uint32_t last_generation = worker.generation.load();
+  started_workers_.fetch_add(1);
+  while (true)
+  {
+    for (int i = 0; i < kSpinIterations && worker.generation.load() == last_generation; ++i)
+    {
+      cpu_relax();
+    }
+    while (true)
+    {
+      // the caller sees the flag after publishing a task and wakes this thread up
+      worker.sleeping.store(true);
+      const uint32_t generation = worker.generation.load();
+      if (generation != last_generation)
+      {
+        worker.sleeping.store(false);
+        last_generation = generation;
+        break;
+      }
+      futex_wait(worker.generation, generation);
+      worker.sleeping.store(false);
+    }
+    if (stop_.load())
+    {
+      return;
+    }
+
+    (*worker.function)(index);
+
+    worker.busy = false;
+    finished_tasks_.fetch_add(1);
+    if (caller_sleeping_.load())
+    {
+      futex_wake_all(finished_tasks_);
+    }
+  }
+}
+
+}  // namespace hardware_interface
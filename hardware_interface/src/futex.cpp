@@ -0,0 +1,60 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hardware_interface/futex.hpp"
+
+#include <climits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace hardware_interface
+{
+void futex_wait(std::atomic<uint32_t> & word, uint32_t expected, std::chrono::nanoseconds timeout)
+{
+#ifdef __linux__
+  timespec relative_timeout;
+  relative_timeout.tv_sec =
+    static_cast<decltype(relative_timeout.tv_sec)>(timeout.count() / 1000000000);
+  relative_timeout.tv_nsec =
+    static_cast<decltype(relative_timeout.tv_nsec)>(timeout.count() % 1000000000);
+  syscall(
+    SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected,
+    timeout > std::chrono::nanoseconds::zero() ? &relative_timeout : nullptr, nullptr, 0);
+#else
+  (void)timeout;
+  if (word.load() == expected)
+  {
+    std::this_thread::yield();
+  }
+#endif
+}
+
+void futex_wake_all(std::atomic<uint32_t> & word)
+{
+#ifdef __linux__
+  syscall(
+    SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr,
+    0);
+#else
+  (void)word;
+#endif
+}
+
+}  // namespace hardware_interface
@@ -14,10 +14,18 @@
 
 #include "hardware_interface/resource_manager.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <functional>
-#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -25,11 +33,16 @@
 #include "hardware_interface/actuator.hpp"
 #include "hardware_interface/actuator_interface.hpp"
 #include "hardware_interface/component_parser.hpp"
+#include "hardware_interface/component_thread_pool.hpp"
 #include "hardware_interface/hardware_component_info.hpp"
+#include "hardware_interface/interface_value_arena.hpp"
+#include "hardware_interface/ring_buffer.hpp"
 #include "hardware_interface/sensor.hpp"
 #include "hardware_interface/sensor_interface.hpp"
 #include "hardware_interface/system.hpp"
 #include "hardware_interface/system_interface.hpp"
+#include "hardware_interface/triple_buffer.hpp"
+#include "hardware_interface/types/handle_data_type.hpp"
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 #include "pluginlib/class_loader.hpp"
@@ -82,7 +95,7 @@ public:
   template <class HardwareT, class HardwareInterfaceT>
   void load_hardware(
     const HardwareInfo & hardware_info, pluginlib::ClassLoader<HardwareInterfaceT> & loader,
-    std::vector<HardwareT> & container)
+    std::deque<HardwareT> & container)
   {
     RCUTILS_LOG_INFO_NAMED(
       "resource_manager", "Loading hardware '%s' ", hardware_info.name.c_str());
@@ -143,10 +156,7 @@ public:
       for (const auto & interface : hardware_info_map_[hardware.get_name()].state_interfaces)
       {
         // add all state interfaces to available list
-        auto found_it = std::find(
-          available_state_interfaces_.begin(), available_state_interfaces_.end(), interface);
-
-        if (found_it == available_state_interfaces_.end())
+        if (state_interfaces_.set_available(interface, true))
         {
           available_state_interfaces_.emplace_back(interface);
           RCUTILS_LOG_DEBUG_NAMED(
@@ -169,10 +179,7 @@ public:
       for (const auto & interface : hardware_info_map_[hardware.get_name()].command_interfaces)
       {
         // TODO(destogl): check if interface should be available on configure
-        auto found_it = std::find(
-          available_command_interfaces_.begin(), available_command_interfaces_.end(), interface);
-
-        if (found_it == available_command_interfaces_.end())
+        if (command_interfaces_.set_available(interface, true))
         {
           available_command_interfaces_.emplace_back(interface);
           RCUTILS_LOG_DEBUG_NAMED(
@@ -206,12 +213,10 @@ public:
       // remove all command interfaces from available list
       for (const auto & interface : hardware_info_map_[hardware.get_name()].command_interfaces)
       {
-        auto found_it = std::find(
-          available_command_interfaces_.begin(), available_command_interfaces_.end(), interface);
-
-        if (found_it != available_command_interfaces_.end())
+        if (command_interfaces_.set_available(interface, false))
         {
-          available_command_interfaces_.erase(found_it);
+          available_command_interfaces_.erase(std::find(
+            available_command_interfaces_.begin(), available_command_interfaces_.end(), interface));
           RCUTILS_LOG_DEBUG_NAMED(
             "resource_manager", "(hardware '%s'): '%s' command removed from available list",
             hardware.get_name().c_str(), interface.c_str());
@@ -230,12 +235,10 @@ public:
       // remove all state interfaces from available list
       for (const auto & interface : hardware_info_map_[hardware.get_name()].state_interfaces)
       {
-        auto found_it = std::find(
-          available_state_interfaces_.begin(), available_state_interfaces_.end(), interface);
-
-        if (found_it != available_state_interfaces_.end())
+        if (state_interfaces_.set_available(interface, false))
         {
-          available_state_interfaces_.erase(found_it);
+          available_state_interfaces_.erase(std::find(
+            available_state_interfaces_.begin(), available_state_interfaces_.end(), interface));
           RCUTILS_LOG_DEBUG_NAMED(
             "resource_manager", "(hardware '%s'): '%s' state interface removed from available list",
             hardware.get_name().c_str(), interface.c_str());
@@ -281,6 +284,10 @@ public:
     if (result)
     {
       // TODO(destogl): make all command interfaces available (currently are all available)
+      if (auto * execution = find_execution(hardware.get_name()))
+      {
+        execution->resume();
+      }
     }
 
     return result;
@@ -306,6 +313,13 @@ public:
   {
     using lifecycle_msgs::msg::State;
 
+    // the thread of an asynchronous component does not access it during the transition
+    std::unique_lock<std::mutex> async_lock;
+    if (auto * async = find_async_component(hardware.get_name()))
+    {
+      async_lock = std::unique_lock<std::mutex>(async->mutex);
+    }
+
     bool result = false;
 
     switch (target_state.id())
@@ -397,92 +411,980 @@ public:
         break;
     }
 
+    if (result)
+    {
+      pull_values(hardware.get_name());
+    }
     return result;
   }
 
+  /// Interned full name of a registered interface
+  using InterfaceId = size_t;
+
+  /// Registered interfaces of one kind, identified by their interned full names.
+  /**
+   * The id of an interface is its index in the dense tables, so availability and claims are
+   * checked with a single hash lookup of the name, or none at all if the id is known.
+   */
+  template <class HandleT>
+  struct InterfaceTable
+  {
+    /// \return false if no interface with full name \p key is registered.
+    bool find(const std::string & key, InterfaceId & id) const
+    {
+      const auto found_it = ids.find(key);
+      if (found_it == ids.end())
+      {
+        return false;
+      }
+      id = found_it->second;
+      return true;
+    }
+
+    bool exists(const std::string & key) const { return ids.find(key) != ids.end(); }
+
+    bool is_available(const std::string & key) const
+    {
+      InterfaceId id;
+      return find(key, id) && available[id];
+    }
+
+    /// \return false if the interface does not exist or its availability did not change.
+    bool set_available(const std::string & key, bool value)
+    {
+      InterfaceId id;
+      if (!find(key, id) || static_cast<bool>(available[id]) == value)
+      {
+        return false;
+      }
+      available[id] = value;
+      return true;
+    }
+
+    /// Register \p interface, unless an interface with the same full name is registered already.
+    void add(const std::string & key, HandleT && interface, size_t value_index)
+    {
+      if (!ids.emplace(key, names.size()).second)
+      {
+        return;
+      }
+      names.push_back(key);
+      interfaces.push_back(std::make_unique<HandleT>(std::move(interface)));
+      value_indexes.push_back(value_index);
+      available.push_back(false);
+      claimed.emplace_back(false);
+    }
+
+    std::vector<std::string> get_sorted_names() const
+    {
+      auto sorted_names = names;
+      std::sort(sorted_names.begin(), sorted_names.end());
+      return sorted_names;
+    }
+
+    std::unordered_map<std::string, InterfaceId> ids;
+
+    // indexed by the id of the interface
+    std::vector<std::string> names;
+    /// Loans reference the interfaces, which therefore do not move when the table grows
+    std::vector<std::unique_ptr<HandleT>> interfaces;
+    /// Index of the interface's value in the value arena
+    std::vector<size_t> value_indexes;
+    /// Flags are bytes instead of bits of a std::vector<bool> to be cheap to read and write
+    std::vector<uint8_t> available;
+    /// Only used for command interfaces. Loans release their interface by resetting its flag,
+    /// which is neither moved by a growing deque nor needs a lock.
+    std::deque<std::atomic<bool>> claimed;
+  };
+
+  /// Lock-free execution time statistics of read or write, recorded by the update loop.
+  struct ExecutionStatistics
+  {
+    void record(std::chrono::nanoseconds duration)
+    {
+      const auto value = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+      last.store(value, std::memory_order_relaxed);
+      sum.fetch_add(value, std::memory_order_relaxed);
+      if (value > max.load(std::memory_order_relaxed))
+      {
+        max.store(value, std::memory_order_relaxed);
+      }
+      count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    HardwareComponentExecutionStatistics get() const
+    {
+      HardwareComponentExecutionStatistics statistics;
+      statistics.count = count.load(std::memory_order_relaxed);
+      statistics.last = std::chrono::nanoseconds(last.load(std::memory_order_relaxed));
+      statistics.max = std::chrono::nanoseconds(max.load(std::memory_order_relaxed));
+      if (statistics.count > 0)
+      {
+        statistics.mean =
+          std::chrono::nanoseconds(sum.load(std::memory_order_relaxed) / statistics.count);
+      }
+      statistics.timeout_count = timeout_count.load(std::memory_order_relaxed);
+      statistics.error_count = error_count.load(std::memory_order_relaxed);
+      return statistics;
+    }
+
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> last{0};
+    std::atomic<uint64_t> max{0};
+    std::atomic<uint64_t> timeout_count{0};
+    std::atomic<uint64_t> error_count{0};
+  };
+
+  /// Read and write of a loaded hardware component as executed by the update loop.
+  struct ComponentExecution
+  {
+    std::string name;
+    /// 0 for actuators, 1 for sensors and 2 for systems, which are executed in this order
+    int order = 0;
+    std::function<return_type()> read;
+    /// Not set for sensors
+    std::function<return_type()> write;
+    ExecutionStatistics read_statistics;
+    ExecutionStatistics write_statistics;
+    /// Read and write only exchange values with the thread of an asynchronous component
+    bool is_async = false;
+    /// Read and written by its own thread of the thread pool
+    bool in_thread_pool = false;
+    /// Interfaces exported by the component, pointing to the values owned by the component
+    std::vector<StateInterface> state_interfaces;
+    std::vector<CommandInterface> command_interfaces;
+    /// Index of the first state and command value of the component in the value arena
+    size_t state_values_index = 0;
+    size_t command_values_index = 0;
+
+    /// Trigger the error transition of the component
+    std::function<void()> error;
+    /// Error policy, set outside of the update loop
+    std::atomic<HardwareErrorAction> error_action{HardwareErrorAction::ERROR_TRANSITION};
+    std::atomic<unsigned int> error_threshold{1};
+    std::atomic<unsigned int> skip_cycles{100};
+    std::atomic_bool timeouts_fail_cycle{false};
+    /// Set when read and write are no longer executed, until the component is activated again
+    std::atomic_bool halted{false};
+    /// Set when the action of the error policy has to be completed outside of the update loop
+    std::atomic_bool action_pending{false};
+    std::atomic<uint64_t> skipped_count{0};
+    /// Error handling state, only accessed by the thread executing the component while it is
+    /// not halted
+    bool cycle_failed = false;
+    uint64_t consecutive_errors = 0;
+    unsigned int skip_remaining = 0;
+
+    /// Whether read and write are executed in the current cycle.
+    bool is_executed() const { return !halted.load() && skip_remaining == 0; }
+
+    /// Count a failed cycle when read or write failed, and take the action of the error policy
+    /// once the threshold is reached.
+    void handle_result(bool ok)
+    {
+      if (ok || cycle_failed)
+      {
+        return;
+      }
+      cycle_failed = true;
+      if (++consecutive_errors != error_threshold.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+      switch (error_action.load(std::memory_order_relaxed))
+      {
+        case HardwareErrorAction::ERROR_TRANSITION:
+          error();
+          break;
+        case HardwareErrorAction::RETRY:
+          break;
+        case HardwareErrorAction::SKIP:
+          skip_remaining = skip_cycles.load(std::memory_order_relaxed);
+          consecutive_errors = 0;
+          break;
+        case HardwareErrorAction::DEACTIVATE:
+          halted = true;
+          action_pending = true;
+          break;
+        case HardwareErrorAction::STOP_CONTROLLERS:
+          action_pending = true;
+          break;
+      }
+    }
+
+    /// Called after the last of read and write of each cycle, even if they were not executed.
+    void end_cycle()
+    {
+      if (halted.load())
+      {
+        return;
+      }
+      // the failed cycle which triggered skipping is not counted as skipped
+      if (skip_remaining > 0 && !cycle_failed)
+      {
+        --skip_remaining;
+        skipped_count.fetch_add(1, std::memory_order_relaxed);
+      }
+      else if (!cycle_failed)
+      {
+        consecutive_errors = 0;
+      }
+      cycle_failed = false;
+    }
+
+    /// Resume reading and writing after the component was halted by its error policy.
+    void resume()
+    {
+      if (!halted.load())
+      {
+        return;
+      }
+      cycle_failed = false;
+      consecutive_errors = 0;
+      skip_remaining = 0;
+      halted = false;
+    }
+  };
+
+  using ExecutionMethod = std::function<return_type()> ComponentExecution::*;
+  using ExecutionStatisticsMember = ExecutionStatistics ComponentExecution::*;
+
+  /// Call method, record its execution time and count errors and exceeding a non-zero timeout.
+  /**
+   * \return false if the method returned an error, or exceeded the timeout and \p timeout_fails.
+   */
+  static bool execute(
+    const std::function<return_type()> & method, ExecutionStatistics & statistics,
+    std::chrono::nanoseconds timeout, bool count_timeout, bool timeout_fails)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const bool ok = method() == return_type::OK;
+    const auto duration = std::chrono::steady_clock::now() - start;
+    statistics.record(duration);
+    if (!ok)
+    {
+      statistics.error_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    const bool timed_out = timeout > std::chrono::nanoseconds::zero() && duration > timeout;
+    if (timed_out && count_timeout)
+    {
+      statistics.timeout_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ok && !(timed_out && timeout_fails);
+  }
+
+  /// Execute read or write of a component unless its error policy skips it.
+  /**
+   * Only called by the thread executing the component.
+   */
+  static void execute(
+    ComponentExecution & execution, const std::function<return_type()> & method,
+    ExecutionStatistics & statistics, std::chrono::nanoseconds timeout, bool count_timeout = true)
+  {
+    if (execution.is_executed())
+    {
+      execution.handle_result(execute(
+        method, statistics, timeout, count_timeout,
+        execution.timeouts_fail_cycle.load(std::memory_order_relaxed)));
+    }
+  }
+
+  static void execute(
+    ComponentExecution & execution, ExecutionMethod method, ExecutionStatisticsMember statistics,
+    std::chrono::nanoseconds timeout, bool count_timeout = true)
+  {
+    const auto & function = execution.*method;
+    if (!function)
+    {
+      return;
+    }
+    if (execution.is_async)
+    {
+      // asynchronous components are executed and their errors handled by their own thread
+      function();
+      return;
+    }
+    execute(execution, function, execution.*statistics, timeout, count_timeout);
+    // sensors have no write, their cycle ends with read
+    if (method == &ComponentExecution::write || !execution.write)
+    {
+      execution.end_cycle();
+    }
+  }
+
+  /// Only inactive and active components are read and written.
   template <class HardwareT>
-  void import_state_interfaces(HardwareT & hardware)
+  static bool is_operational(const HardwareT & hardware)
+  {
+    const auto id = hardware.get_state().id();
+    return id == lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE ||
+           id == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE;
+  }
+
+  ComponentExecution * find_execution(const std::string & component_name)
   {
-    auto interfaces = hardware.export_state_interfaces();
-    std::vector<std::string> interface_names;
-    interface_names.reserve(interfaces.size());
-    for (auto & interface : interfaces)
+    for (const auto & execution : component_executions_)
     {
-      auto key = interface.get_full_name();
-      state_interface_map_.emplace(std::make_pair(key, std::move(interface)));
-      interface_names.push_back(key);
+      if (execution->name == component_name)
+      {
+        return execution.get();
+      }
+    }
+    return nullptr;
+  }
+
+  /// Number of values of \p interfaces, array interfaces have more than one value.
+  template <class HandleT>
+  static size_t count_values(const std::vector<HandleT> & interfaces)
+  {
+    size_t count = 0;
+    for (const auto & interface : interfaces)
+    {
+      count += interface.get_size();
     }
-    hardware_info_map_[hardware.get_name()].state_interfaces = interface_names;
+    return count;
+  }
+
+  /// Copy the values of \p interface into \p values, whose storage holds values of any data type.
+  static void copy_values(const ReadOnlyHandle & interface, double * values)
+  {
+    std::memcpy(
+      values, interface.get_data_ptr(), get_size(interface.get_data_type()) * interface.get_size());
+  }
+
+  /// Copy \p values into the values of \p interface, whatever its data type.
+  static void copy_values(const double * values, ReadWriteHandle & interface)
+  {
+    std::memcpy(
+      interface.get_data_ptr(), values, get_size(interface.get_data_type()) * interface.get_size());
+  }
+
+  /// Copy the values of the component's state interfaces into the arena.
+  void pull_states(const ComponentExecution & execution)
+  {
+    double * values = values_.data() + execution.state_values_index;
+    for (const auto & interface : execution.state_interfaces)
+    {
+      if (interface)
+      {
+        copy_values(interface, values);
+      }
+      values += interface.get_size();
+    }
+  }
+
+  /// Copy the values of the component's command interfaces into the arena.
+  void pull_commands(const ComponentExecution & execution)
+  {
+    double * values = values_.data() + execution.command_values_index;
+    for (const auto & interface : execution.command_interfaces)
+    {
+      if (interface)
+      {
+        copy_values(interface, values);
+      }
+      values += interface.get_size();
+    }
+  }
+
+  /// Copy the command values in the arena to the component's command interfaces.
+  void push_commands(ComponentExecution & execution)
+  {
+    const double * values = values_.data() + execution.command_values_index;
+    for (auto & interface : execution.command_interfaces)
+    {
+      if (interface)
+      {
+        copy_values(values, interface);
+      }
+      values += interface.get_size();
+    }
+  }
+
+  /// Hardware component which is read and written by its own thread at its own rate.
+  /**
+   * The interfaces registered in the resource manager point to the value arena, which is accessed
+   * only by the update loop. Its values are exchanged with the values of the component through
+   * lock-free triple buffers, so neither the update loop nor the component's thread ever waits
+   * for the other one.
+   *
+   * The component itself is only accessed by its thread and, under the mutex held by the thread
+   * for each cycle, by lifecycle transitions and the preparation of command mode switches. The
+   * update loop hands the mode switch over to the thread instead of performing it.
+   */
+  struct AsyncComponent
+  {
+    explicit AsyncComponent(InterfaceValueArena & arena) : values(arena) {}
+
+    ~AsyncComponent()
+    {
+      stop = true;
+      if (thread.joinable())
+      {
+        thread.join();
+      }
+    }
+
+    /// Called by the update loop instead of read().
+    return_type fetch_states()
+    {
+      if (state_buffer->fetch())
+      {
+        const auto & states = state_buffer->front();
+        std::copy(states.begin(), states.end(), values.data() + execution->state_values_index);
+      }
+      return return_type::OK;
+    }
+
+    /// Called by the update loop instead of write().
+    return_type publish_commands()
+    {
+      const double * commands = values.data() + execution->command_values_index;
+      auto & buffer = command_buffer->back();
+      std::copy(commands, commands + buffer.size(), buffer.begin());
+      command_buffer->publish();
+      return return_type::OK;
+    }
+
+    void start(
+      ComponentExecution & component_execution, unsigned int rate,
+      const std::atomic<std::chrono::nanoseconds::rep> & timeout)
+    {
+      execution = &component_execution;
+      const double * states = values.data() + execution->state_values_index;
+      state_buffer = std::make_unique<TripleBuffer<std::vector<double>>>(
+        std::vector<double>(states, states + count_values(execution->state_interfaces)));
+      const double * commands = values.data() + execution->command_values_index;
+      command_buffer = std::make_unique<TripleBuffer<std::vector<double>>>(
+        std::vector<double>(commands, commands + count_values(execution->command_interfaces)));
+
+      read = std::move(execution->read);
+      write = std::move(execution->write);
+      execution->read = std::bind(&AsyncComponent::fetch_states, this);
+      if (write)
+      {
+        execution->write = std::bind(&AsyncComponent::publish_commands, this);
+      }
+      execution->is_async = true;
+
+      const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate));
+      thread = std::thread(&AsyncComponent::run, this, period, std::cref(timeout));
+    }
+
+    void run(
+      std::chrono::steady_clock::duration period,
+      const std::atomic<std::chrono::nanoseconds::rep> & timeout)
+    {
+      auto & state_interfaces = execution->state_interfaces;
+      auto & command_interfaces = execution->command_interfaces;
+      auto next_cycle = std::chrono::steady_clock::now();
+      while (!stop.load())
+      {
+        const std::chrono::nanoseconds current_timeout(timeout.load(std::memory_order_relaxed));
+        std::unique_lock<std::mutex> lock(mutex);
+        perform_command_mode_switch();
+
+        if (command_buffer->fetch())
+        {
+          const double * commands = command_buffer->front().data();
+          for (auto & interface : command_interfaces)
+          {
+            if (interface)
+            {
+              copy_values(commands, interface);
+            }
+            commands += interface.get_size();
+          }
+        }
+
+        execute(*execution, read, execution->read_statistics, current_timeout);
+
+        double * states = state_buffer->back().data();
+        for (const auto & interface : state_interfaces)
+        {
+          if (interface)
+          {
+            copy_values(interface, states);
+          }
+          states += interface.get_size();
+        }
+        state_buffer->publish();
+
+        if (write)
+        {
+          execute(*execution, write, execution->write_statistics, current_timeout);
+        }
+        execution->end_cycle();
+        check_command_mode_switch();
+        lock.unlock();
+
+        // skip cycles which were missed instead of trying to catch up
+        next_cycle += period;
+        const auto now = std::chrono::steady_clock::now();
+        if (next_cycle < now)
+        {
+          next_cycle = now;
+        }
+        std::this_thread::sleep_until(next_cycle);
+      }
+    }
+
+    /// Called with the mutex held before the mode switch is requested.
+    bool prepare_command_mode_switch(
+      const std::vector<std::string> & start, const std::vector<std::string> & stop)
+    {
+      if (prepare_mode_switch(start, stop) != return_type::OK)
+      {
+        return false;
+      }
+      start_interfaces = start;
+      stop_interfaces = stop;
+      return true;
+    }
+
+    /// Called by the update loop instead of perform_command_mode_switch().
+    void request_command_mode_switch()
+    {
+      mode_switch_done = false;
+      mode_switch_requested = true;
+    }
+
+    /// Called by the update loop instead of is_command_mode_switch_done().
+    /**
+     * Until the thread reports the whole mode switch of the component as done, only interfaces
+     * which are not switched by the component are done.
+     */
+    bool is_command_mode_switch_done(const std::vector<std::string> & interfaces) const
+    {
+      if (mode_switch_done.load())
+      {
+        return true;
+      }
+      return std::none_of(interfaces.begin(), interfaces.end(), [this](const auto & key) {
+        return std::find(start_interfaces.begin(), start_interfaces.end(), key) !=
+               start_interfaces.end();
+      });
+    }
+
+    /// Perform the mode switch requested by the update loop, called by the thread.
+    void perform_command_mode_switch()
+    {
+      if (!mode_switch_requested.exchange(false))
+      {
+        return;
+      }
+      mode_switch_performed =
+        perform_mode_switch(start_interfaces, stop_interfaces) == return_type::OK;
+      if (!mode_switch_performed)
+      {
+        // the started controllers are deactivated after the timeout of the mode switch
+        RCUTILS_LOG_ERROR_NAMED(
+          "resource_manager", "Component '%s' could not perform switch",
+          execution->name.c_str());
+      }
+    }
+
+    /// Report the performed mode switch as done once the component completed it.
+    void check_command_mode_switch()
+    {
+      if (mode_switch_performed && is_mode_switch_done(start_interfaces))
+      {
+        mode_switch_performed = false;
+        mode_switch_done = true;
+      }
+    }
+
+    /// Only accessed by the update loop
+    InterfaceValueArena & values;
+    /// After start, its interfaces are only accessed by the component's thread
+    ComponentExecution * execution = nullptr;
+    std::unique_ptr<TripleBuffer<std::vector<double>>> state_buffer;
+    std::unique_ptr<TripleBuffer<std::vector<double>>> command_buffer;
+
+    std::function<return_type()> read;
+    std::function<return_type()> write;
+    /// Mode switch methods of the component, not set for sensors
+    std::function<return_type(const std::vector<std::string> &, const std::vector<std::string> &)>
+      prepare_mode_switch;
+    std::function<return_type(const std::vector<std::string> &, const std::vector<std::string> &)>
+      perform_mode_switch;
+    std::function<bool(const std::vector<std::string> &)> is_mode_switch_done;
+    /// Interfaces of the prepared mode switch, written under the mutex while no switch is pending
+    std::vector<std::string> start_interfaces;
+    std::vector<std::string> stop_interfaces;
+    std::atomic_bool mode_switch_requested{false};
+    std::atomic_bool mode_switch_done{true};
+    /// Only accessed by the thread
+    bool mode_switch_performed = false;
+
+    /// Held by the thread while it accesses the component
+    std::mutex mutex;
+    std::thread thread;
+    std::atomic_bool stop{false};
+  };
+
+  AsyncComponent * find_async_component(const std::string & component_name)
+  {
+    for (const auto & async : async_components_)
+    {
+      if (async->execution->name == component_name)
+      {
+        return async.get();
+      }
+    }
+    return nullptr;
+  }
+
+  AsyncComponent * create_async_component(const HardwareInfo & hardware_info)
+  {
+    if (!hardware_info.is_async)
+    {
+      return nullptr;
+    }
+    if (hardware_info.rw_rate == 0)
+    {
+      RCUTILS_LOG_ERROR_NAMED(
+        "resource_manager",
+        "Asynchronous hardware '%s' has no read/write rate, it is read and written synchronously.",
+        hardware_info.name.c_str());
+      return nullptr;
+    }
+    RCUTILS_LOG_INFO_NAMED(
+      "resource_manager", "Hardware '%s' is read and written asynchronously at %u Hz",
+      hardware_info.name.c_str(), hardware_info.rw_rate);
+    async_components_.push_back(std::make_unique<AsyncComponent>(values_));
+    return async_components_.back().get();
+  }
+
+  /// Reserve the arena for the interfaces described by \p hardware_infos.
+  /**
+   * Components exporting the described interfaces are imported without moving the values, which
+   * would require to register all interfaces again.
+   */
+  void reserve_values(const std::vector<HardwareInfo> & hardware_infos)
+  {
+    size_t count = 0;
+    for (const auto & hardware_info : hardware_infos)
+    {
+      for (const auto * components :
+           {&hardware_info.joints, &hardware_info.sensors, &hardware_info.gpios})
+      {
+        for (const auto & component : *components)
+        {
+          for (const auto & interface : component.state_interfaces)
+          {
+            count += static_cast<size_t>(std::max(interface.size, 1));
+          }
+          for (const auto & interface : component.command_interfaces)
+          {
+            count += static_cast<size_t>(std::max(interface.size, 1));
+          }
+        }
+      }
+    }
+    // one block of state and one block of command values per component
+    values_.reserve(count, 2 * hardware_infos.size());
+  }
+
+  /// Interface of the resource manager pointing to value \p index of the arena.
+  template <class HandleT>
+  HandleT bind_to_arena(const HandleT & interface, size_t index)
+  {
+    // interfaces without a value stay without a value, every data type fits into a value
+    return HandleT(
+      interface.get_name(), interface.get_interface_name(), interface.get_data_type(),
+      interface ? static_cast<void *>(&values_[index]) : nullptr, interface.get_size());
+  }
+
+  /// Point the interfaces of \p table to the values again after the arena moved them.
+  /**
+   * The handles are assigned in place, as loaned interfaces reference them. Only the value
+   * pointers cached by the loans for their unchecked accessors are invalidated, as importing
+   * components is documented to do.
+   */
+  template <class HandleT>
+  void rebind_interfaces(InterfaceTable<HandleT> & table)
+  {
+    for (InterfaceId id = 0; id < table.interfaces.size(); ++id)
+    {
+      *table.interfaces[id] = bind_to_arena(*table.interfaces[id], table.value_indexes[id]);
+    }
+  }
+
+  /// Export the component's interfaces and register interfaces pointing to the value arena.
+  /**
+   * The state and the command values of each component are contiguous blocks which start at a
+   * cache line, so components read and written in parallel never share a cache line.
+   */
+  template <class HardwareT>
+  void import_interfaces(HardwareT & hardware, ComponentExecution & execution)
+  {
+    execution.state_interfaces = hardware.export_state_interfaces();
+    if constexpr (!std::is_same<HardwareT, Sensor>::value)
+    {
+      execution.command_interfaces = hardware.export_command_interfaces();
+    }
+
+    const double * previous_values = values_.data();
+    execution.state_values_index = values_.allocate(count_values(execution.state_interfaces));
+    execution.command_values_index = values_.allocate(count_values(execution.command_interfaces));
+    if (values_.data() != previous_values)
+    {
+      rebind_interfaces(state_interfaces_);
+      rebind_interfaces(command_interfaces_);
+    }
+    pull_states(execution);
+    pull_commands(execution);
+
+    std::vector<std::string> state_interface_names;
+    state_interface_names.reserve(execution.state_interfaces.size());
+    size_t value_index = execution.state_values_index;
+    for (const auto & interface : execution.state_interfaces)
+    {
+      const auto key = interface.get_full_name();
+      state_interfaces_.add(key, bind_to_arena(interface, value_index), value_index);
+      state_interface_names.push_back(key);
+      value_index += interface.get_size();
+    }
+    hardware_info_map_[hardware.get_name()].state_interfaces = state_interface_names;
     available_state_interfaces_.reserve(
-      available_state_interfaces_.capacity() + interface_names.size());
+      available_state_interfaces_.capacity() + state_interface_names.size());
+
+    if constexpr (!std::is_same<HardwareT, Sensor>::value)
+    {
+      std::vector<std::string> command_interface_names;
+      command_interface_names.reserve(execution.command_interfaces.size());
+      value_index = execution.command_values_index;
+      for (const auto & interface : execution.command_interfaces)
+      {
+        const auto key = interface.get_full_name();
+        command_interfaces_.add(key, bind_to_arena(interface, value_index), value_index);
+        command_interface_names.push_back(key);
+        value_index += interface.get_size();
+      }
+      hardware_info_map_[hardware.get_name()].command_interfaces = command_interface_names;
+      available_command_interfaces_.reserve(
+        available_command_interfaces_.capacity() + command_interface_names.size());
+    }
   }
 
+  /// Initialize the last component of \p container and add it to the executed components.
   template <class HardwareT>
-  void import_command_interfaces(HardwareT & hardware)
+  void import_hardware(
+    const HardwareInfo & hardware_info, std::deque<HardwareT> & container, int order)
+  {
+    // references to the elements of a deque stay valid when it grows, also while the threads of
+    // asynchronous components use them
+    HardwareT & hardware = container.back();
+    initialize_hardware(hardware_info, hardware);
+
+    auto execution = std::make_unique<ComponentExecution>();
+    execution->name = hardware.get_name();
+    execution->order = order;
+    // errors are handled by the executing thread according to the error policy
+    execution->error = [&hardware]() { hardware.error(); };
+    import_interfaces(hardware, *execution);
+
+    // the values are exchanged with the arena by the thread calling read and write, see
+    // execute_components(), or by the asynchronous component
+    execution->read = [&hardware]() {
+      return is_operational(hardware) ? hardware.read(false) : return_type::OK;
+    };
+    if constexpr (!std::is_same<HardwareT, Sensor>::value)
+    {
+      execution->write = [&hardware]() {
+        return is_operational(hardware) ? hardware.write(false) : return_type::OK;
+      };
+    }
+
+    if (auto async = create_async_component(hardware_info))
+    {
+      if constexpr (!std::is_same<HardwareT, Sensor>::value)
+      {
+        async->prepare_mode_switch = [&hardware](const auto & start, const auto & stop) {
+          return hardware.prepare_command_mode_switch(start, stop);
+        };
+        async->perform_mode_switch = [&hardware](const auto & start, const auto & stop) {
+          return hardware.perform_command_mode_switch(start, stop);
+        };
+        async->is_mode_switch_done = [&hardware](const auto & interfaces) {
+          return hardware.is_command_mode_switch_done(interfaces);
+        };
+      }
+      async->start(*execution, hardware_info.rw_rate, read_write_timeout_);
+    }
+
+    auto position = std::upper_bound(
+      component_executions_.begin(), component_executions_.end(), order,
+      [](int value, const auto & item) { return value < item->order; });
+    component_executions_.insert(position, std::move(execution));
+  }
+
+  /// Update the arena with the values a component set during a lifecycle transition.
+  void pull_values(const std::string & component_name)
+  {
+    for (const auto & execution : component_executions_)
+    {
+      // values of asynchronous components are only accessed by their own thread
+      if (execution->name == component_name && !execution->is_async)
+      {
+        pull_states(*execution);
+        pull_commands(*execution);
+      }
+    }
+  }
+
+  /// Publish a snapshot of the arena to the consumer of the snapshots, called at the end of read().
+  void publish_snapshot()
+  {
+    const uint64_t read_count = read_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!snapshots_)
+    {
+      return;
+    }
+    // the consumer did not keep up, the snapshot is dropped
+    auto * snapshot = snapshots_->back();
+    if (!snapshot)
+    {
+      return;
+    }
+    snapshot->version = read_count;
+    snapshot->stamp = std::chrono::steady_clock::now();
+    std::memcpy(snapshot->values.data(), values_.data(), snapshot->values.size() * sizeof(double));
+    snapshots_->publish();
+  }
+
+  template <class HandleT>
+  std::vector<SnapshotInterfaceInfo> get_snapshot_layout(
+    const InterfaceTable<HandleT> & interfaces, size_t snapshot_size) const
+  {
+    std::vector<SnapshotInterfaceInfo> layout;
+    layout.reserve(interfaces.interfaces.size());
+    for (InterfaceId id = 0; id < interfaces.interfaces.size(); ++id)
+    {
+      const auto & interface = *interfaces.interfaces[id];
+      const size_t index = interfaces.value_indexes[id];
+      // values of components loaded after enabling the snapshots are missing
+      if (index + interface.get_size() <= snapshot_size)
+      {
+        layout.push_back(
+          {interfaces.names[id], index, interface.get_size(), interface.get_data_type()});
+      }
+    }
+    return layout;
+  }
+
+  /// Create one thread for each component imported so far, called once.
+  bool create_thread_pool(const std::vector<int> & cpus, int priority)
+  {
+    for (const auto & execution : component_executions_)
+    {
+      execution->in_thread_pool = true;
+      pool_executions_.push_back(execution.get());
+    }
+    thread_pool_ =
+      std::make_unique<ComponentThreadPool>(pool_executions_.size(), cpus, priority);
+    return thread_pool_->is_configured();
+  }
+
+  /// Execute read or write of all components, in parallel if the thread pool exists.
+  /**
+   * The values of the components are exchanged with the arena only by the calling thread, so a
+   * component which did not finish within the timeout never accesses the arena while the update
+   * loop uses it. Such a component is skipped until it finished, the values it exchanges are the
+   * ones of its last call which finished in time.
+   */
+  void execute_components(
+    ExecutionMethod method, ExecutionStatisticsMember statistics,
+    const ComponentThreadPool::Function & task)
   {
-    auto interfaces = hardware.export_command_interfaces();
-    std::vector<std::string> interface_names;
-    interface_names.reserve(interfaces.size());
-    for (auto & interface : interfaces)
+    const bool is_write = method == &ComponentExecution::write;
+    const std::chrono::nanoseconds timeout(read_write_timeout_.load(std::memory_order_relaxed));
+    if (thread_pool_)
     {
-      auto key = interface.get_full_name();
-      command_interface_map_.emplace(std::make_pair(key, std::move(interface)));
-      claimed_command_interface_map_.emplace(std::make_pair(key, false));
-      interface_names.push_back(key);
+      thread_pool_->run(task, timeout, is_write ? push_task_ : ComponentThreadPool::Function());
+      for (size_t i = 0; i < pool_executions_.size(); ++i)
+      {
+        auto & execution = *pool_executions_[i];
+        if (!thread_pool_->is_triggered(i))
+        {
+          // still executing the previous call, counted once per cycle like skipping by the error
+          // policy, the previous call fails its cycle if it exceeded the timeout
+          if (is_write || !execution.write)
+          {
+            execution.skipped_count.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+        else if (thread_pool_->is_busy(i))
+        {
+          (execution.*statistics).timeout_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (!is_write && !execution.is_async)
+        {
+          pull_states(execution);
+        }
+      }
+    }
+
+    // components imported after the thread pool was created are executed by the calling thread
+    for (auto & execution : component_executions_)
+    {
+      if (execution->in_thread_pool)
+      {
+        continue;
+      }
+      if (is_write && !execution->is_async)
+      {
+        push_commands(*execution);
+      }
+      execute(*execution, method, statistics, timeout);
+      if (!is_write && !execution->is_async)
+      {
+        pull_states(*execution);
+      }
     }
-    hardware_info_map_[hardware.get_name()].command_interfaces = interface_names;
-    available_command_interfaces_.reserve(
-      available_command_interfaces_.capacity() + interface_names.size());
   }
 
   // TODO(destogl): Propagate "false" up, if happens in initialize_hardware
   void initialize_actuator(const HardwareInfo & hardware_info)
   {
     load_hardware<Actuator, ActuatorInterface>(hardware_info, actuator_loader_, actuators_);
-    initialize_hardware(hardware_info, actuators_.back());
-    import_state_interfaces(actuators_.back());
-    import_command_interfaces(actuators_.back());
+    import_hardware(hardware_info, actuators_, 0);
   }
 
   void initialize_sensor(const HardwareInfo & hardware_info)
   {
     load_hardware<Sensor, SensorInterface>(hardware_info, sensor_loader_, sensors_);
-    initialize_hardware(hardware_info, sensors_.back());
-    import_state_interfaces(sensors_.back());
+    import_hardware(hardware_info, sensors_, 1);
   }
 
   void initialize_system(const HardwareInfo & hardware_info)
   {
     load_hardware<System, SystemInterface>(hardware_info, system_loader_, systems_);
-    initialize_hardware(hardware_info, systems_.back());
-    import_state_interfaces(systems_.back());
-    import_command_interfaces(systems_.back());
+    import_hardware(hardware_info, systems_, 2);
   }
 
   void initialize_actuator(
     std::unique_ptr<ActuatorInterface> actuator, const HardwareInfo & hardware_info)
   {
     this->actuators_.emplace_back(Actuator(std::move(actuator)));
-    initialize_hardware(hardware_info, actuators_.back());
-    import_state_interfaces(actuators_.back());
-    import_command_interfaces(actuators_.back());
+    import_hardware(hardware_info, actuators_, 0);
   }
 
   void initialize_sensor(
     std::unique_ptr<SensorInterface> sensor, const HardwareInfo & hardware_info)
   {
     this->sensors_.emplace_back(Sensor(std::move(sensor)));
-    initialize_hardware(hardware_info, sensors_.back());
-    import_state_interfaces(sensors_.back());
+    import_hardware(hardware_info, sensors_, 1);
   }
 
   void initialize_system(
     std::unique_ptr<SystemInterface> system, const HardwareInfo & hardware_info)
   {
     this->systems_.emplace_back(System(std::move(system)));
-    initialize_hardware(hardware_info, systems_.back());
-    import_state_interfaces(systems_.back());
-    import_command_interfaces(systems_.back());
+    import_hardware(hardware_info, systems_, 2);
   }
 
   // hardware plugins
@@ -490,23 +1392,65 @@ public:
   pluginlib::ClassLoader<SensorInterface> sensor_loader_;
   pluginlib::ClassLoader<SystemInterface> system_loader_;
 
-  std::vector<Actuator> actuators_;
-  std::vector<Sensor> sensors_;
-  std::vector<System> systems_;
+  /// Deques, as the executions of the components reference them
+  std::deque<Actuator> actuators_;
+  std::deque<Sensor> sensors_;
+  std::deque<System> systems_;
 
   std::unordered_map<std::string, HardwareComponentInfo> hardware_info_map_;
 
-  /// Storage of all available state interfaces
-  std::map<std::string, StateInterface> state_interface_map_;
-  /// Storage of all available command interfaces
-  std::map<std::string, CommandInterface> command_interface_map_;
+  /// Storage of all registered state interfaces
+  InterfaceTable<StateInterface> state_interfaces_;
+  /// Storage of all registered command interfaces, including which of them are claimed
+  InterfaceTable<CommandInterface> command_interfaces_;
 
   /// Vectors with interfaces available to controllers (depending on hardware component state)
   std::vector<std::string> available_state_interfaces_;
   std::vector<std::string> available_command_interfaces_;
 
-  /// List of all claimed command interfaces
-  std::unordered_map<std::string, bool> claimed_command_interface_map_;
+  /// Values of all registered state and command interfaces
+  InterfaceValueArena values_;
+
+  /// Read and write of all components in the order of execution
+  std::vector<std::unique_ptr<ComponentExecution>> component_executions_;
+  std::atomic<std::chrono::nanoseconds::rep> read_write_timeout_{0};
+  /// Declared after the components and executions to stop the threads before destroying them
+  std::vector<std::unique_ptr<AsyncComponent>> async_components_;
+
+  /// Snapshots of the arena taken at the end of read(), consumed by a single thread
+  std::unique_ptr<RingBuffer<StateSnapshot>> snapshots_;
+  /// Number of values in each snapshot
+  size_t snapshot_size_ = 0;
+  /// Number of read() calls, the version of the snapshots
+  std::atomic<uint64_t> read_count_{0};
+
+  // timeouts are counted by execute_components when executing in parallel
+  const ComponentThreadPool::Function read_task_ = [this](size_t index) {
+    execute(
+      *pool_executions_[index], &ComponentExecution::read,
+      &ComponentExecution::read_statistics,
+      std::chrono::nanoseconds(read_write_timeout_.load(std::memory_order_relaxed)), false);
+  };
+  const ComponentThreadPool::Function write_task_ = [this](size_t index) {
+    execute(
+      *pool_executions_[index], &ComponentExecution::write,
+      &ComponentExecution::write_statistics,
+      std::chrono::nanoseconds(read_write_timeout_.load(std::memory_order_relaxed)), false);
+  };
+  /// Called by the thread calling write() before the write of an idle thread is triggered
+  const ComponentThreadPool::Function push_task_ = [this](size_t index) {
+    if (!pool_executions_[index]->is_async)
+    {
+      push_commands(*pool_executions_[index]);
+    }
+  };
+
+  /// Component executed by each thread of the pool, in the order of the threads
+  std::vector<ComponentExecution *> pool_executions_;
+  /// Threads executing read and write of one component each, if enabled. Created once and
+  /// declared last to stop the threads, which waits for hung components, only when the resource
+  /// manager is destroyed.
+  std::unique_ptr<ComponentThreadPool> thread_pool_;
 };
 
 ResourceManager::ResourceManager() : resource_storage_(std::make_unique<ResourceStorage>()) {}
@@ -537,6 +1481,10 @@ void ResourceManager::load_urdf(const std::string & urdf, bool validate_interfac
   const std::string actuator_type = "actuator";
 
   const auto hardware_info = hardware_interface::parse_control_resources_from_urdf(urdf);
+  {
+    std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+    resource_storage_->reserve_values(hardware_info);
+  }
   for (const auto & individual_hardware_info : hardware_info)
   {
     if (individual_hardware_info.type == actuator_type)
@@ -567,24 +1515,41 @@ void ResourceManager::load_urdf(const std::string & urdf, bool validate_interfac
 
 LoanedStateInterface ResourceManager::claim_state_interface(const std::string & key)
 {
-  if (!state_interface_is_available(key))
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  auto & state_interfaces = resource_storage_->state_interfaces_;
+  ResourceStorage::InterfaceId id;
+  if (!state_interfaces.find(key, id) || !state_interfaces.available[id])
   {
     throw std::runtime_error(std::string("State interface with key '") + key + "' does not exist");
   }
+  return LoanedStateInterface(*state_interfaces.interfaces[id]);
+}
+
+std::vector<LoanedStateInterface> ResourceManager::claim_state_interfaces(
+  const std::vector<std::string> & keys)
+{
+  std::vector<LoanedStateInterface> loans;
+  loans.reserve(keys.size());
 
   std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  return LoanedStateInterface(resource_storage_->state_interface_map_.at(key));
+  auto & state_interfaces = resource_storage_->state_interfaces_;
+  for (const auto & key : keys)
+  {
+    ResourceStorage::InterfaceId id;
+    if (!state_interfaces.find(key, id) || !state_interfaces.available[id])
+    {
+      throw std::runtime_error(
+        std::string("State interface with key '") + key + "' does not exist");
+    }
+    loans.emplace_back(*state_interfaces.interfaces[id]);
+  }
+  return loans;
 }
 
 std::vector<std::string> ResourceManager::state_interface_keys() const
 {
-  std::vector<std::string> keys;
   std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  for (const auto & item : resource_storage_->state_interface_map_)
-  {
-    keys.push_back(std::get<0>(item));
-  }
-  return keys;
+  return resource_storage_->state_interfaces_.get_sorted_names();
 }
 
 std::vector<std::string> ResourceManager::available_state_interfaces() const
@@ -595,69 +1560,94 @@ std::vector<std::string> ResourceManager::available_state_interfaces() const
 bool ResourceManager::state_interface_exists(const std::string & key) const
 {
   std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  return resource_storage_->state_interface_map_.find(key) !=
-         resource_storage_->state_interface_map_.end();
+  return resource_storage_->state_interfaces_.exists(key);
 }
 
 bool ResourceManager::state_interface_is_available(const std::string & name) const
 {
   std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  return std::find(
-           resource_storage_->available_state_interfaces_.begin(),
-           resource_storage_->available_state_interfaces_.end(),
-           name) != resource_storage_->available_state_interfaces_.end();
+  return resource_storage_->state_interfaces_.is_available(name);
 }
 
 // CM API
 bool ResourceManager::command_interface_is_claimed(const std::string & key) const
 {
-  if (!command_interface_is_available(key))
-  {
-    return false;
-  }
-
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
   std::lock_guard<std::recursive_mutex> guard_claimed(claimed_command_interfaces_lock_);
-  return resource_storage_->claimed_command_interface_map_.at(key);
+  const auto & command_interfaces = resource_storage_->command_interfaces_;
+  ResourceStorage::InterfaceId id;
+  return command_interfaces.find(key, id) && command_interfaces.available[id] &&
+         command_interfaces.claimed[id];
 }
 
 // CM API: Called in "update"-thread
 LoanedCommandInterface ResourceManager::claim_command_interface(const std::string & key)
 {
-  if (!command_interface_is_available(key))
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  std::lock_guard<std::recursive_mutex> guard_claimed(claimed_command_interfaces_lock_);
+  auto & command_interfaces = resource_storage_->command_interfaces_;
+  ResourceStorage::InterfaceId id;
+  if (!command_interfaces.find(key, id) || !command_interfaces.available[id])
   {
     throw std::runtime_error(std::string("Command interface with '") + key + "' does not exist");
   }
-
-  std::lock_guard<std::recursive_mutex> guard_claimed(claimed_command_interfaces_lock_);
-  if (command_interface_is_claimed(key))
+  if (command_interfaces.claimed[id])
   {
     throw std::runtime_error(
       std::string("Command interface with '") + key + "' is already claimed");
   }
 
-  resource_storage_->claimed_command_interface_map_[key] = true;
-  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  return LoanedCommandInterface(
-    resource_storage_->command_interface_map_.at(key),
-    std::bind(&ResourceManager::release_command_interface, this, key));
+  command_interfaces.claimed[id] = true;
+  return LoanedCommandInterface(*command_interfaces.interfaces[id], command_interfaces.claimed[id]);
 }
 
 // CM API: Called in "update"-thread
-void ResourceManager::release_command_interface(const std::string & key)
+std::vector<LoanedCommandInterface> ResourceManager::claim_command_interfaces(
+  const std::vector<std::string> & keys)
 {
+  std::vector<LoanedCommandInterface> loans;
+  loans.reserve(keys.size());
+
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
   std::lock_guard<std::recursive_mutex> guard_claimed(claimed_command_interfaces_lock_);
-  resource_storage_->claimed_command_interface_map_[key] = false;
+  auto & command_interfaces = resource_storage_->command_interfaces_;
+  // resolve each key once, the ids are reused for claiming and loaning
+  std::vector<ResourceStorage::InterfaceId> ids(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    if (!command_interfaces.find(keys[i], ids[i]) || !command_interfaces.available[ids[i]])
+    {
+      throw std::runtime_error(
+        std::string("Command interface with '") + keys[i] + "' does not exist");
+    }
+  }
+
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    if (command_interfaces.claimed[ids[i]])
+    {
+      // release the interfaces claimed so far, which also catches duplicated keys
+      for (size_t j = 0; j < i; ++j)
+      {
+        command_interfaces.claimed[ids[j]] = false;
+      }
+      throw std::runtime_error(
+        std::string("Command interface with '") + keys[i] + "' is already claimed");
+    }
+    command_interfaces.claimed[ids[i]] = true;
+  }
+
+  for (const auto id : ids)
+  {
+    loans.emplace_back(*command_interfaces.interfaces[id], command_interfaces.claimed[id]);
+  }
+  return loans;
 }
 
 std::vector<std::string> ResourceManager::command_interface_keys() const
 {
-  std::vector<std::string> keys;
   std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  for (const auto & item : resource_storage_->command_interface_map_)
-  {
-    keys.push_back(std::get<0>(item));
-  }
-  return keys;
+  return resource_storage_->command_interfaces_.get_sorted_names();
 }
 
 std::vector<std::string> ResourceManager::available_command_interfaces() const
@@ -669,18 +1659,14 @@ std::vector<std::string> ResourceManager::available_command_interfaces() const
 bool ResourceManager::command_interface_exists(const std::string & key) const
 {
   std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  return resource_storage_->command_interface_map_.find(key) !=
-         resource_storage_->command_interface_map_.end();
+  return resource_storage_->command_interfaces_.exists(key);
 }
 
 // CM API
 bool ResourceManager::command_interface_is_available(const std::string & name) const
 {
   std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
-  return std::find(
-           resource_storage_->available_command_interfaces_.begin(),
-           resource_storage_->available_command_interfaces_.end(),
-           name) != resource_storage_->available_command_interfaces_.end();
+  return resource_storage_->command_interfaces_.is_available(name);
 }
 
 size_t ResourceManager::actuator_components_size() const
@@ -731,6 +1717,18 @@ std::unordered_map<std::string, HardwareComponentInfo> ResourceManager::get_comp
   {
     resource_storage_->hardware_info_map_[component.get_name()].state = component.get_state();
   }
+  for (const auto & execution : resource_storage_->component_executions_)
+  {
+    auto & component_info = resource_storage_->hardware_info_map_[execution->name];
+    component_info.read_statistics = execution->read_statistics.get();
+    component_info.write_statistics = execution->write_statistics.get();
+    component_info.error_policy.action = execution->error_action.load();
+    component_info.error_policy.error_threshold = execution->error_threshold.load();
+    component_info.error_policy.skip_cycles = execution->skip_cycles.load();
+    component_info.error_policy.timeouts_fail_cycle = execution->timeouts_fail_cycle.load();
+    component_info.skipped_cycles = execution->skipped_count.load();
+    component_info.is_halted = execution->halted.load();
+  }
 
   return resource_storage_->hardware_info_map_;
 }
@@ -756,9 +1754,20 @@ bool ResourceManager::prepare_command_mode_switch(
     return ss.str();
   };
 
+  auto prepare = [&](auto & component) {
+    // asynchronous components keep the interfaces to perform the switch in their own thread
+    if (auto * async = resource_storage_->find_async_component(component.get_name()))
+    {
+      std::lock_guard<std::mutex> lock(async->mutex);
+      return async->prepare_command_mode_switch(start_interfaces, stop_interfaces);
+    }
+    return return_type::OK ==
+           component.prepare_command_mode_switch(start_interfaces, stop_interfaces);
+  };
+
   for (auto & component : resource_storage_->actuators_)
   {
-    if (return_type::OK != component.prepare_command_mode_switch(start_interfaces, stop_interfaces))
+    if (!prepare(component))
     {
       RCUTILS_LOG_ERROR_NAMED(
         "resource_manager", "Component '%s' did not accept new command resource combination: \n %s",
@@ -768,7 +1777,7 @@ bool ResourceManager::prepare_command_mode_switch(
   }
   for (auto & component : resource_storage_->systems_)
   {
-    if (return_type::OK != component.prepare_command_mode_switch(start_interfaces, stop_interfaces))
+    if (!prepare(component))
     {
       RCUTILS_LOG_ERROR_NAMED(
         "resource_manager", "Component '%s' did not accept new command resource combination: \n %s",
@@ -783,9 +1792,21 @@ bool ResourceManager::perform_command_mode_switch(
   const std::vector<std::string> & start_interfaces,
   const std::vector<std::string> & stop_interfaces)
 {
+  auto perform = [&](auto & component) {
+    // asynchronous components perform the prepared switch in their own thread, a failure is
+    // only logged there and keeps the switch from being done
+    if (auto * async = resource_storage_->find_async_component(component.get_name()))
+    {
+      async->request_command_mode_switch();
+      return true;
+    }
+    return return_type::OK ==
+           component.perform_command_mode_switch(start_interfaces, stop_interfaces);
+  };
+
   for (auto & component : resource_storage_->actuators_)
   {
-    if (return_type::OK != component.perform_command_mode_switch(start_interfaces, stop_interfaces))
+    if (!perform(component))
     {
       RCUTILS_LOG_ERROR_NAMED(
         "resource_manager", "Component '%s' could not perform switch",
@@ -795,7 +1816,7 @@ bool ResourceManager::perform_command_mode_switch(
   }
   for (auto & component : resource_storage_->systems_)
   {
-    if (return_type::OK != component.perform_command_mode_switch(start_interfaces, stop_interfaces))
+    if (!perform(component))
     {
       RCUTILS_LOG_ERROR_NAMED(
         "resource_manager", "Component '%s' could not perform switch",
@@ -806,6 +1827,33 @@ bool ResourceManager::perform_command_mode_switch(
   return true;
 }
 
+bool ResourceManager::is_command_mode_switch_done(const std::vector<std::string> & interfaces)
+{
+  auto is_done = [&](auto & component) {
+    if (auto * async = resource_storage_->find_async_component(component.get_name()))
+    {
+      return async->is_command_mode_switch_done(interfaces);
+    }
+    return component.is_command_mode_switch_done(interfaces);
+  };
+
+  for (auto & component : resource_storage_->actuators_)
+  {
+    if (!is_done(component))
+    {
+      return false;
+    }
+  }
+  for (auto & component : resource_storage_->systems_)
+  {
+    if (!is_done(component))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 return_type ResourceManager::set_component_state(
   const std::string & component_name, rclcpp_lifecycle::State & target_state)
 {
@@ -888,32 +1936,143 @@ return_type ResourceManager::set_component_state(
   return result;
 }
 
-void ResourceManager::read()
+bool ResourceManager::enable_parallel_read_write(const std::vector<int> & cpus, int priority)
 {
-  for (auto & component : resource_storage_->actuators_)
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  if (resource_storage_->thread_pool_)
   {
-    component.read();
+    RCUTILS_LOG_ERROR_NAMED(
+      "resource_manager", "Parallel read and write of the hardware components is already enabled.");
+    return false;
   }
-  for (auto & component : resource_storage_->sensors_)
+  return resource_storage_->create_thread_pool(cpus, priority);
+}
+
+void ResourceManager::set_read_write_timeout(std::chrono::nanoseconds timeout)
+{
+  resource_storage_->read_write_timeout_ = timeout.count();
+}
+
+bool ResourceManager::set_error_policy(
+  const std::string & component_name, const HardwareErrorPolicy & policy)
+{
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  auto * execution = resource_storage_->find_execution(component_name);
+  if (!execution)
   {
-    component.read();
+    RCUTILS_LOG_ERROR_NAMED(
+      "resource_manager", "Hardware component '%s' does not exist, cannot set its error policy.",
+      component_name.c_str());
+    return false;
   }
-  for (auto & component : resource_storage_->systems_)
+  execution->error_action = policy.action;
+  execution->error_threshold = std::max(policy.error_threshold, 1u);
+  execution->skip_cycles = policy.skip_cycles;
+  execution->timeouts_fail_cycle = policy.timeouts_fail_cycle;
+  return true;
+}
+
+std::vector<std::string> ResourceManager::take_failed_components()
+{
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  std::vector<std::string> failed_components;
+  for (const auto & execution : resource_storage_->component_executions_)
   {
-    component.read();
+    if (execution->action_pending.exchange(false))
+    {
+      failed_components.push_back(execution->name);
+    }
   }
+  return failed_components;
+}
+
+void ResourceManager::read()
+{
+  resource_storage_->execute_components(
+    &ResourceStorage::ComponentExecution::read,
+    &ResourceStorage::ComponentExecution::read_statistics, resource_storage_->read_task_);
+  resource_storage_->publish_snapshot();
 }
 
 void ResourceManager::write()
 {
-  for (auto & component : resource_storage_->actuators_)
+  resource_storage_->execute_components(
+    &ResourceStorage::ComponentExecution::write,
+    &ResourceStorage::ComponentExecution::write_statistics, resource_storage_->write_task_);
+}
+
+void ResourceManager::enable_state_snapshots(size_t capacity)
+{
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  // read() and consume_state_snapshot() access the ring without locking
+  if (resource_storage_->read_count_.load(std::memory_order_relaxed) != 0)
   {
-    component.write();
+    throw std::runtime_error("State snapshots have to be enabled before the first read()");
   }
-  for (auto & component : resource_storage_->systems_)
+  if (capacity == 0)
   {
-    component.write();
+    resource_storage_->snapshots_.reset();
+    resource_storage_->snapshot_size_ = 0;
+    return;
   }
+  resource_storage_->snapshot_size_ = resource_storage_->values_.size();
+  StateSnapshot snapshot;
+  snapshot.values.resize(resource_storage_->snapshot_size_);
+  resource_storage_->snapshots_ =
+    std::make_unique<RingBuffer<StateSnapshot>>(capacity, snapshot);
+}
+
+StateSnapshotLayout ResourceManager::get_state_snapshot_layout() const
+{
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  const size_t snapshot_size = resource_storage_->snapshot_size_;
+  StateSnapshotLayout layout;
+  layout.state_interfaces =
+    resource_storage_->get_snapshot_layout(resource_storage_->state_interfaces_, snapshot_size);
+  layout.command_interfaces =
+    resource_storage_->get_snapshot_layout(resource_storage_->command_interfaces_, snapshot_size);
+  return layout;
+}
+
+bool ResourceManager::consume_state_snapshot(
+  const std::function<void(const StateSnapshot &)> & consumer)
+{
+  auto & snapshots = resource_storage_->snapshots_;
+  if (!snapshots)
+  {
+    return false;
+  }
+  const auto * snapshot = snapshots->front();
+  if (!snapshot)
+  {
+    return false;
+  }
+  consumer(*snapshot);
+  snapshots->pop();
+  return true;
+}
+
+size_t ResourceManager::get_interface_value_count() const
+{
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  return resource_storage_->values_.size();
+}
+
+StateSnapshotLayout ResourceManager::get_interface_value_layout() const
+{
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  const size_t value_count = resource_storage_->values_.size();
+  StateSnapshotLayout layout;
+  layout.state_interfaces =
+    resource_storage_->get_snapshot_layout(resource_storage_->state_interfaces_, value_count);
+  layout.command_interfaces =
+    resource_storage_->get_snapshot_layout(resource_storage_->command_interfaces_, value_count);
+  return layout;
+}
+
+const double * ResourceManager::get_interface_values() const
+{
+  return resource_storage_->values_.data();
 }
 
 void ResourceManager::validate_storage(
@@ -953,6 +2112,55 @@ void ResourceManager::validate_storage(
     }
   }
 
+  // interfaces keep the data type and size they are exported with, warn if the description differs
+  std::lock_guard<std::recursive_mutex> guard(resource_interfaces_lock_);
+  const auto check_interface = [](const auto & interfaces, const std::string & key,
+                                  const InterfaceInfo & interface_info)
+  {
+    size_t id;
+    if (!interfaces.find(key, id))
+    {
+      return;
+    }
+    const auto & interface = *interfaces.interfaces[id];
+    HandleDataType data_type;
+    if (
+      from_string(interface_info.data_type, data_type) && interface.get_data_type() != data_type)
+    {
+      RCUTILS_LOG_WARN_NAMED(
+        "resource_manager", "Interface '%s' is described as '%s' but exported as '%s'.",
+        key.c_str(), interface_info.data_type.c_str(),
+        to_string(interface.get_data_type()).c_str());
+    }
+    if (interface_info.size > 0 && interface.get_size() != static_cast<size_t>(interface_info.size))
+    {
+      RCUTILS_LOG_WARN_NAMED(
+        "resource_manager", "Interface '%s' is described with %d values but exported with %zu.",
+        key.c_str(), interface_info.size, interface.get_size());
+    }
+  };
+  for (const auto & hardware : hardware_info)
+  {
+    for (const auto * components : {&hardware.joints, &hardware.sensors, &hardware.gpios})
+    {
+      for (const auto & component : *components)
+      {
+        for (const auto & state_interface : component.state_interfaces)
+        {
+          check_interface(
+            resource_storage_->state_interfaces_, component.name + "/" + state_interface.name,
+            state_interface);
+        }
+        for (const auto & command_interface : component.command_interfaces)
+        {
+          check_interface(
+            resource_storage_->command_interfaces_, component.name + "/" + command_interface.name,
+            command_interface);
+        }
+      }
+    }
+  }
+
   if (!missing_state_keys.empty() || !missing_command_keys.empty())
   {
     std::string err_msg = "Wrong state or command interface configuration.\n";
@@ -193,7 +193,7 @@ std::string Sensor::get_name() const { return impl_->get_name(); }
 
 const rclcpp_lifecycle::State & Sensor::get_state() const { return impl_->get_state(); }
 
-return_type Sensor::read()
+return_type Sensor::read(bool handle_error)
 {
   return_type result = return_type::ERROR;
   if (
@@ -201,7 +201,7 @@ return_type Sensor::read()
     impl_->get_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
   {
     result = impl_->read();
-    if (result == return_type::ERROR)
+    if (result == return_type::ERROR && handle_error)
     {
       error();
     }
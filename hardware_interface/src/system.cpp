@@ -208,11 +208,16 @@ return_type System::perform_command_mode_switch(
   return impl_->perform_command_mode_switch(start_interfaces, stop_interfaces);
 }
 
+bool System::is_command_mode_switch_done(const std::vector<std::string> & interfaces)
+{
+  return impl_->is_command_mode_switch_done(interfaces);
+}
+
 std::string System::get_name() const { return impl_->get_name(); }
 
 const rclcpp_lifecycle::State & System::get_state() const { return impl_->get_state(); }
 
-return_type System::read()
+return_type System::read(bool handle_error)
 {
   return_type result = return_type::ERROR;
   if (
@@ -220,7 +225,7 @@ return_type System::read()
     impl_->get_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
   {
     result = impl_->read();
-    if (result == return_type::ERROR)
+    if (result == return_type::ERROR && handle_error)
     {
       error();
     }
@@ -228,7 +233,7 @@ return_type System::read()
   return result;
 }
 
-return_type System::write()
+return_type System::write(bool handle_error)
 {
   return_type result = return_type::ERROR;
   if (
@@ -236,7 +241,7 @@ return_type System::write()
     impl_->get_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
   {
     result = impl_->write();
-    if (result == return_type::ERROR)
+    if (result == return_type::ERROR && handle_error)
     {
       error();
     }
@@ -0,0 +1,74 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hardware_interface/thread_configuration.hpp"
+
+#include <cerrno>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace hardware_interface
+{
+bool configure_sched_fifo(int priority)
+{
+#ifdef __linux__
+  sched_param schedp;
+  schedp.sched_priority = priority;
+  const int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &schedp);
+  if (ret != 0)
+  {
+    errno = ret;
+    return false;
+  }
+  return true;
+#else
+  (void)priority;
+  errno = ENOTSUP;
+  return false;
+#endif
+}
+
+bool set_thread_affinity(const std::vector<int> & cpus)
+{
+#ifdef __linux__
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (const auto cpu : cpus)
+  {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+      errno = EINVAL;
+      return false;
+    }
+    CPU_SET(cpu, &cpuset);
+  }
+  const int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+  if (ret != 0)
+  {
+    errno = ret;
+    return false;
+  }
+  return true;
+#else
+  (void)cpus;
+  errno = ENOTSUP;
+  return false;
+#endif
+}
+
+}  // namespace hardware_interface
@@ -0,0 +1,139 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hardware_interface/resource_manager.hpp"
+#include "hardware_interface/system_interface.hpp"
+#include "hardware_interface/types/lifecycle_state_names.hpp"
+#include "lifecycle_msgs/msg/state.hpp"
+#include "rclcpp_lifecycle/state.hpp"
+
+namespace
+{
+class BenchmarkSystem : public hardware_interface::SystemInterface
+{
+public:
+  explicit BenchmarkSystem(size_t joint_count) : values_(2 * joint_count, 0.0) {}
+
+  std::vector<hardware_interface::StateInterface> export_state_interfaces() override
+  {
+    std::vector<hardware_interface::StateInterface> state_interfaces;
+    for (size_t i = 0; i < values_.size() / 2; ++i)
+    {
+      state_interfaces.emplace_back("joint" + std::to_string(i), "position", &values_[2 * i]);
+    }
+    return state_interfaces;
+  }
+
+  std::vector<hardware_interface::CommandInterface> export_command_interfaces() override
+  {
+    std::vector<hardware_interface::CommandInterface> command_interfaces;
+    for (size_t i = 0; i < values_.size() / 2; ++i)
+    {
+      command_interfaces.emplace_back("joint" + std::to_string(i), "position", &values_[2 * i + 1]);
+    }
+    return command_interfaces;
+  }
+
+  hardware_interface::return_type read() override { return hardware_interface::return_type::OK; }
+
+  hardware_interface::return_type write() override { return hardware_interface::return_type::OK; }
+
+private:
+  std::vector<double> values_;
+};
+
+/// Resource manager with an active system of \p joint_count joints.
+std::unique_ptr<hardware_interface::ResourceManager> make_resource_manager(size_t joint_count)
+{
+  auto rm = std::make_unique<hardware_interface::ResourceManager>();
+  hardware_interface::HardwareInfo hardware_info;
+  hardware_info.name = "BenchmarkSystem";
+  hardware_info.type = "system";
+  rm->import_component(std::make_unique<BenchmarkSystem>(joint_count), hardware_info);
+  rclcpp_lifecycle::State active(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE,
+    hardware_interface::lifecycle_state_names::ACTIVE);
+  rm->set_component_state("BenchmarkSystem", active);
+  return rm;
+}
+}  // namespace
+
+static void BM_claim_release_command_interface(benchmark::State & state)
+{
+  auto rm = make_resource_manager(static_cast<size_t>(state.range(0)));
+  const std::string key = "joint0/position";
+  for (auto _ : state)
+  {
+    auto loan = rm->claim_command_interface(key);
+    benchmark::DoNotOptimize(loan);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_claim_release_command_interface)->Arg(10)->Arg(2000);
+
+static void BM_claim_release_command_interfaces(benchmark::State & state)
+{
+  auto rm = make_resource_manager(static_cast<size_t>(state.range(0)));
+  const auto keys = rm->available_command_interfaces();
+  for (auto _ : state)
+  {
+    auto loans = rm->claim_command_interfaces(keys);
+    benchmark::DoNotOptimize(loans.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_claim_release_command_interfaces)->Arg(10)->Arg(2000);
+
+static void BM_claim_release_state_interfaces(benchmark::State & state)
+{
+  auto rm = make_resource_manager(static_cast<size_t>(state.range(0)));
+  const auto keys = rm->available_state_interfaces();
+  for (auto _ : state)
+  {
+    auto loans = rm->claim_state_interfaces(keys);
+    benchmark::DoNotOptimize(loans.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_claim_release_state_interfaces)->Arg(10)->Arg(2000);
+
+/// Moving loans, e.g., into the controller, must not allocate either.
+static void BM_move_command_interface_loans(benchmark::State & state)
+{
+  auto rm = make_resource_manager(static_cast<size_t>(state.range(0)));
+  auto loans = rm->claim_command_interfaces(rm->available_command_interfaces());
+  std::vector<hardware_interface::LoanedCommandInterface> moved_loans;
+  moved_loans.reserve(loans.size());
+  for (auto _ : state)
+  {
+    for (auto & loan : loans)
+    {
+      moved_loans.emplace_back(std::move(loan));
+    }
+    loans.clear();
+    for (auto & loan : moved_loans)
+    {
+      loans.emplace_back(std::move(loan));
+    }
+    moved_loans.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK(BM_move_command_interface_loans)->Arg(2000);
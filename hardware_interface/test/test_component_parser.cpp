@@ -596,6 +596,50 @@ TEST_F(TestComponentParser, successfully_parse_valid_urdf_system_with_size_and_d
   EXPECT_EQ(hardware_info.gpios[0].state_interfaces[1].size, 1);
 }
 
+TEST_F(TestComponentParser, successfully_parse_valid_urdf_async_sensor)
+{
+  std::string urdf_to_test = std::string(ros2_control_test_assets::urdf_head) +
+                             ros2_control_test_assets::valid_urdf_ros2_control_async_sensor +
+                             ros2_control_test_assets::urdf_tail;
+  const auto control_hardware = parse_control_resources_from_urdf(urdf_to_test);
+  ASSERT_THAT(control_hardware, SizeIs(1));
+  auto hardware_info = control_hardware.front();
+
+  EXPECT_EQ(hardware_info.name, "AsyncForceTorqueSensor");
+  EXPECT_EQ(hardware_info.type, "sensor");
+  EXPECT_TRUE(hardware_info.is_async);
+  EXPECT_EQ(hardware_info.rw_rate, 100u);
+  ASSERT_THAT(hardware_info.sensors, SizeIs(1));
+  EXPECT_THAT(hardware_info.sensors[0].state_interfaces, SizeIs(2));
+
+  // components are synchronous by default
+  urdf_to_test = std::string(ros2_control_test_assets::urdf_head) +
+                 ros2_control_test_assets::valid_urdf_ros2_control_sensor_only +
+                 ros2_control_test_assets::urdf_tail;
+  EXPECT_FALSE(parse_control_resources_from_urdf(urdf_to_test).front().is_async);
+}
+
+TEST_F(TestComponentParser, async_without_rate_throws_error)
+{
+  std::string urdf_to_test =
+    std::string(ros2_control_test_assets::urdf_head) +
+    ros2_control_test_assets::invalid_urdf_ros2_control_async_missing_rate +
+    ros2_control_test_assets::urdf_tail;
+  ASSERT_THROW(parse_control_resources_from_urdf(urdf_to_test), std::runtime_error);
+}
+
+TEST_F(TestComponentParser, async_with_out_of_range_rate_throws_error)
+{
+  for (const std::string rate : {"4294967296", "99999999999999999999999"})
+  {
+    std::string async_sensor = ros2_control_test_assets::valid_urdf_ros2_control_async_sensor;
+    async_sensor.replace(async_sensor.find("\"100\""), 5, "\"" + rate + "\"");
+    std::string urdf_to_test = std::string(ros2_control_test_assets::urdf_head) + async_sensor +
+                               ros2_control_test_assets::urdf_tail;
+    EXPECT_THROW(parse_control_resources_from_urdf(urdf_to_test), std::runtime_error) << rate;
+  }
+}
+
 TEST_F(TestComponentParser, negative_size_throws_error)
 {
   std::string urdf_to_test = std::string(ros2_control_test_assets::urdf_head) +
@@ -0,0 +1,92 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "hardware_interface/component_thread_pool.hpp"
+
+using hardware_interface::ComponentThreadPool;
+using namespace std::chrono_literals;
+
+TEST(TestComponentThreadPool, executes_each_task_on_its_own_thread)
+{
+  ComponentThreadPool pool(3);
+  ASSERT_EQ(3u, pool.get_thread_count());
+  EXPECT_TRUE(pool.is_configured());
+
+  std::vector<std::thread::id> thread_ids(3);
+  std::vector<int> call_counts(3, 0);
+  const ComponentThreadPool::Function task = [&](size_t index) {
+    thread_ids[index] = std::this_thread::get_id();
+    ++call_counts[index];
+  };
+
+  for (int cycle = 0; cycle < 100; ++cycle)
+  {
+    EXPECT_EQ(0u, pool.run(task, 0ns));
+  }
+  EXPECT_THAT(call_counts, ::testing::Each(100));
+  EXPECT_NE(std::this_thread::get_id(), thread_ids[0]);
+  EXPECT_NE(thread_ids[0], thread_ids[1]);
+  EXPECT_NE(thread_ids[1], thread_ids[2]);
+  EXPECT_NE(thread_ids[0], thread_ids[2]);
+}
+
+TEST(TestComponentThreadPool, does_not_wait_for_tasks_which_timed_out)
+{
+  ComponentThreadPool pool(2);
+  std::atomic_bool release_hung_task{false};
+  std::atomic<int> fast_task_calls{0};
+  std::atomic<int> hung_task_calls{0};
+  const ComponentThreadPool::Function task = [&](size_t index) {
+    if (index == 0)
+    {
+      ++fast_task_calls;
+      return;
+    }
+    ++hung_task_calls;
+    while (!release_hung_task.load())
+    {
+      std::this_thread::sleep_for(100us);
+    }
+  };
+
+  EXPECT_EQ(1u, pool.run(task, 5ms));
+  EXPECT_TRUE(pool.is_busy(1));
+
+  // the hung task is skipped and does not delay the other tasks
+  std::vector<int> prepare_calls(2, 0);
+  const ComponentThreadPool::Function prepare = [&](size_t index) { ++prepare_calls[index]; };
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(1u, pool.run(task, 1s, prepare));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+  EXPECT_EQ(2, fast_task_calls.load());
+  EXPECT_EQ(1, hung_task_calls.load());
+  EXPECT_TRUE(pool.is_triggered(0));
+  EXPECT_FALSE(pool.is_triggered(1));
+  EXPECT_THAT(prepare_calls, ::testing::ElementsAre(1, 0));
+
+  release_hung_task = true;
+  while (pool.is_busy(1))
+  {
+    std::this_thread::sleep_for(100us);
+  }
+  EXPECT_EQ(0u, pool.run(task, 0ns));
+  EXPECT_EQ(2, hung_task_calls.load());
+}
@@ -13,9 +13,16 @@
 // limitations under the License.
 
 #include <gmock/gmock.h>
+
+#include <vector>
+
 #include "hardware_interface/handle.hpp"
+#include "hardware_interface/loaned_command_interface.hpp"
+#include "hardware_interface/loaned_state_interface.hpp"
 
 using hardware_interface::CommandInterface;
+using hardware_interface::LoanedCommandInterface;
+using hardware_interface::LoanedStateInterface;
 using hardware_interface::StateInterface;
 
 namespace
@@ -63,3 +70,98 @@ TEST(TestHandle, value_methods_work_on_non_nullptr)
   EXPECT_NO_THROW(handle.set_value(0.0));
   EXPECT_DOUBLE_EQ(handle.get_value(), 0.0);
 }
+
+TEST(TestHandle, loaned_interfaces_resolve_value_pointers)
+{
+  double state_value = 1.337;
+  double command_value = 0.0;
+  StateInterface state_handle{JOINT_NAME, FOO_INTERFACE, &state_value};
+  CommandInterface command_handle{JOINT_NAME, FOO_INTERFACE, &command_value};
+  EXPECT_EQ(&state_value, state_handle.get_value_ptr());
+  EXPECT_EQ(&command_value, command_handle.get_value_ptr());
+
+  LoanedStateInterface state{state_handle};
+  LoanedCommandInterface command{command_handle};
+  ASSERT_TRUE(state.has_value());
+  ASSERT_TRUE(command.has_value());
+  command.set_value_unchecked(state.get_value_unchecked());
+  EXPECT_DOUBLE_EQ(1.337, command_value);
+  EXPECT_DOUBLE_EQ(1.337, command.get_value_unchecked());
+
+  StateInterface empty_handle{JOINT_NAME, FOO_INTERFACE};
+  EXPECT_EQ(nullptr, empty_handle.get_value_ptr());
+  EXPECT_FALSE(LoanedStateInterface{empty_handle}.has_value());
+  EXPECT_FALSE(LoanedStateInterface{empty_handle}.has_data());
+}
+
+TEST(TestHandle, typed_value_methods_check_the_data_type)
+{
+  bool flag = false;
+  uint8_t mode = 3;
+  CommandInterface flag_handle{JOINT_NAME, FOO_INTERFACE, &flag};
+  StateInterface mode_handle{JOINT_NAME, FOO_INTERFACE, &mode};
+  EXPECT_EQ(hardware_interface::HandleDataType::BOOL, flag_handle.get_data_type());
+  EXPECT_EQ(hardware_interface::HandleDataType::UINT8, mode_handle.get_data_type());
+  EXPECT_TRUE(flag_handle);
+  EXPECT_EQ(nullptr, flag_handle.get_value_ptr());
+
+  EXPECT_NO_THROW(flag_handle.set_typed_value(true));
+  EXPECT_TRUE(flag);
+  EXPECT_TRUE(flag_handle.get_typed_value<bool>());
+  EXPECT_EQ(3u, mode_handle.get_typed_value<uint8_t>());
+
+  EXPECT_THROW(mode_handle.get_typed_value<int32_t>(), std::runtime_error);
+  EXPECT_THROW(flag_handle.set_typed_value(1.0), std::runtime_error);
+  EXPECT_ANY_THROW(flag_handle.get_value());
+
+  double value = 1.337;
+  CommandInterface double_handle{JOINT_NAME, FOO_INTERFACE, &value};
+  EXPECT_EQ(hardware_interface::HandleDataType::DOUBLE, double_handle.get_data_type());
+  EXPECT_DOUBLE_EQ(1.337, double_handle.get_typed_value<double>());
+  EXPECT_THROW(
+    CommandInterface(JOINT_NAME, FOO_INTERFACE).get_typed_value<bool>(), std::runtime_error);
+
+  LoanedCommandInterface flag_loan{flag_handle};
+  LoanedStateInterface mode_loan{mode_handle};
+  ASSERT_TRUE(flag_loan.has_data());
+  ASSERT_TRUE(mode_loan.has_data());
+  // typed values are not accessible through the unchecked accessors
+  EXPECT_FALSE(flag_loan.has_value());
+  EXPECT_FALSE(mode_loan.has_value());
+  flag_loan.set_typed_value(false);
+  EXPECT_FALSE(flag);
+  EXPECT_EQ(3u, mode_loan.get_typed_value<uint8_t>());
+}
+
+TEST(TestHandle, array_interfaces_reference_blocks_of_values)
+{
+  std::vector<double> values = {1.0, 2.0, 3.0};
+  CommandInterface handle{JOINT_NAME, FOO_INTERFACE, values.data(), values.size()};
+  EXPECT_EQ(3u, handle.get_size());
+  EXPECT_DOUBLE_EQ(1.0, handle.get_value());
+
+  auto span = handle.get_values();
+  ASSERT_EQ(3u, span.size());
+  span[1] = 5.0;
+  EXPECT_DOUBLE_EQ(5.0, values[1]);
+
+  LoanedCommandInterface loan{handle};
+  EXPECT_EQ(3u, loan.get_size());
+  const auto & const_loan = loan;
+  EXPECT_EQ(values.data(), const_loan.get_values().data());
+
+  StateInterface scalar_handle{JOINT_NAME, FOO_INTERFACE, &values[2]};
+  EXPECT_EQ(1u, scalar_handle.get_size());
+  EXPECT_DOUBLE_EQ(3.0, LoanedStateInterface{scalar_handle}.get_values()[0]);
+  EXPECT_TRUE(StateInterface(JOINT_NAME, FOO_INTERFACE).get_values().empty());
+}
+
+TEST(TestHandle, only_interfaces_of_doubles_can_be_arrays)
+{
+  bool flags[4] = {true, false, true, false};
+  EXPECT_THROW(
+    StateInterface(JOINT_NAME, FOO_INTERFACE, hardware_interface::HandleDataType::BOOL, flags, 4),
+    std::runtime_error);
+  EXPECT_NO_THROW(
+    StateInterface(JOINT_NAME, FOO_INTERFACE, hardware_interface::HandleDataType::BOOL, flags, 1));
+}
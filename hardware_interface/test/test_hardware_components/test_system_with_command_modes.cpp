@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -70,6 +71,11 @@ public:
       }
     }
 
+    // Test of a hardware which never manages to switch modes
+    const auto fail_param = info_.hardware_parameters.find("fail_command_mode_switch");
+    fail_command_mode_switch_ =
+      fail_param != info_.hardware_parameters.end() && fail_param->second == "true";
+
     fprintf(stderr, "TestSystemCommandModes configured successfully.\n");
     return CallbackReturn::SUCCESS;
   }
@@ -104,7 +110,12 @@ public:
     return command_interfaces;
   }
 
-  hardware_interface::return_type read() override { return hardware_interface::return_type::OK; }
+  hardware_interface::return_type read() override
+  {
+    // the drives acknowledged the switch of the mode
+    switching_interfaces_.clear();
+    return hardware_interface::return_type::OK;
+  }
 
   hardware_interface::return_type write() override { return hardware_interface::return_type::OK; }
 
@@ -162,16 +173,44 @@ public:
     // Fail if given an empty list.
     // This should never occur in a real system as the same start_interfaces list is sent to both
     // prepare and perform, and an error should be handled in prepare.
-    if (start_interfaces.size() == 0)
+    if (start_interfaces.size() == 0 || fail_command_mode_switch_)
     {
       return hardware_interface::return_type::ERROR;
     }
+    // Example of a slow switch: velocity mode is only done after the next read
+    switching_interfaces_.clear();
+    for (const auto & key : start_interfaces)
+    {
+      for (auto i = 0u; i < info_.joints.size(); i++)
+      {
+        if (key == info_.joints[i].name + "/" + hardware_interface::HW_IF_VELOCITY)
+        {
+          switching_interfaces_.push_back(key);
+        }
+      }
+    }
     return hardware_interface::return_type::OK;
   }
 
+  bool is_command_mode_switch_done(const std::vector<std::string> & interfaces) override
+  {
+    for (const auto & key : interfaces)
+    {
+      if (
+        std::find(switching_interfaces_.begin(), switching_interfaces_.end(), key) !=
+        switching_interfaces_.end())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
 private:
   std::vector<std::string> start_modes_ = {"position", "position"};
   std::vector<bool> stop_modes_ = {false, false};
+  std::vector<std::string> switching_interfaces_;
+  bool fail_command_mode_switch_ = false;
 
   std::array<double, 2> position_command_ = {0.0, 0.0};
   std::array<double, 2> velocity_command_ = {0.0, 0.0};
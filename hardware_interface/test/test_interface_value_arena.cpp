@@ -0,0 +1,68 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "hardware_interface/interface_value_arena.hpp"
+
+using hardware_interface::InterfaceValueArena;
+
+TEST(TestInterfaceValueArena, blocks_start_at_cache_lines)
+{
+  InterfaceValueArena arena;
+  EXPECT_EQ(0u, arena.size());
+
+  EXPECT_EQ(0u, arena.allocate(3));
+  EXPECT_EQ(3u, arena.size());
+  EXPECT_EQ(InterfaceValueArena::kValuesPerCacheLine, arena.allocate(9));
+  EXPECT_EQ(3 * InterfaceValueArena::kValuesPerCacheLine, arena.allocate(1));
+  // empty blocks do not waste memory
+  EXPECT_EQ(4 * InterfaceValueArena::kValuesPerCacheLine, arena.allocate(0));
+
+  EXPECT_EQ(
+    0u, reinterpret_cast<std::uintptr_t>(arena.data()) % InterfaceValueArena::kCacheLineSize);
+  EXPECT_EQ(
+    0u, reinterpret_cast<std::uintptr_t>(&arena[InterfaceValueArena::kValuesPerCacheLine]) %
+          InterfaceValueArena::kCacheLineSize);
+}
+
+TEST(TestInterfaceValueArena, keeps_values_when_growing)
+{
+  InterfaceValueArena arena;
+  const auto first = arena.allocate(2);
+  EXPECT_TRUE(std::isnan(arena[first]));
+  arena[first] = 1.0;
+  arena[first + 1] = 2.0;
+
+  const auto second = arena.allocate(100);
+  EXPECT_TRUE(std::isnan(arena[second + 99]));
+  EXPECT_EQ(1.0, arena[first]);
+  EXPECT_EQ(2.0, arena[first + 1]);
+}
+
+TEST(TestInterfaceValueArena, reserved_values_do_not_move)
+{
+  InterfaceValueArena arena;
+  arena.allocate(1);
+  arena.reserve(20, 3);
+  const double * data = arena.data();
+
+  arena.allocate(9);
+  arena.allocate(1);
+  arena.allocate(10);
+  EXPECT_EQ(data, arena.data());
+}
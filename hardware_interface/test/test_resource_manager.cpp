@@ -17,13 +17,18 @@
 #include <gmock/gmock.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "hardware_interface/actuator_interface.hpp"
 #include "hardware_interface/resource_manager.hpp"
+#include "hardware_interface/sensor_interface.hpp"
+#include "hardware_interface/system_interface.hpp"
 #include "hardware_interface/types/lifecycle_state_names.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 #include "rclcpp_lifecycle/state.hpp"
@@ -329,6 +334,466 @@ TEST_F(TestResourceManager, post_initialization_add_components)
   EXPECT_NO_THROW(rm.claim_command_interface("external_joint/external_command_interface"));
 }
 
+class LoopbackActuator : public hardware_interface::ActuatorInterface
+{
+public:
+  explicit LoopbackActuator(const std::string & joint_name = "loopback_joint")
+  : joint_name_(joint_name)
+  {
+  }
+
+  std::vector<hardware_interface::StateInterface> export_state_interfaces() override
+  {
+    std::vector<hardware_interface::StateInterface> state_interfaces;
+    state_interfaces.emplace_back(
+      hardware_interface::StateInterface(joint_name_, "position", &position_state_));
+    return state_interfaces;
+  }
+
+  std::vector<hardware_interface::CommandInterface> export_command_interfaces() override
+  {
+    std::vector<hardware_interface::CommandInterface> command_interfaces;
+    command_interfaces.emplace_back(
+      hardware_interface::CommandInterface(joint_name_, "position", &position_command_));
+    return command_interfaces;
+  }
+
+  hardware_interface::return_type read() override
+  {
+    position_state_ = position_command_;
+    return hardware_interface::return_type::OK;
+  }
+
+  hardware_interface::return_type write() override { return hardware_interface::return_type::OK; }
+
+  std::string joint_name_;
+  double position_state_ = 0.0;
+  double position_command_ = 0.0;
+};
+
+TEST_F(TestResourceManager, async_component_exchanges_values_with_update_loop)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo async_hw_info;
+  async_hw_info.name = "AsyncLoopbackActuator";
+  async_hw_info.type = "actuator";
+  async_hw_info.is_async = true;
+  async_hw_info.rw_rate = 1000;
+  rm.import_component(std::make_unique<LoopbackActuator>(), async_hw_info);
+  activate_components(rm, {"AsyncLoopbackActuator"});
+
+  auto command = rm.claim_command_interface("loopback_joint/position");
+  auto state = rm.claim_state_interface("loopback_joint/position");
+  command.set_value(1.5);
+  rm.write();
+
+  // the component's thread reads it at its own rate, the update loop only fetches the latest state
+  for (int i = 0; i < 1000 && state.get_value() != 1.5; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    rm.read();
+  }
+  EXPECT_EQ(1.5, state.get_value());
+
+  // the statistics are the ones of the component's thread, wait until it ran a few cycles
+  auto status_map = rm.get_components_status();
+  for (int i = 0; i < 1000 && (status_map["AsyncLoopbackActuator"].read_statistics.count <= 1u ||
+                               status_map["AsyncLoopbackActuator"].write_statistics.count <= 1u);
+       ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    status_map = rm.get_components_status();
+  }
+  EXPECT_GT(status_map["AsyncLoopbackActuator"].read_statistics.count, 1u);
+  EXPECT_GT(status_map["AsyncLoopbackActuator"].write_statistics.count, 1u);
+}
+
+class LoopbackSystem : public hardware_interface::SystemInterface
+{
+public:
+  explicit LoopbackSystem(const std::string & joint_name) : joint_name_(joint_name) {}
+
+  std::vector<hardware_interface::StateInterface> export_state_interfaces() override
+  {
+    std::vector<hardware_interface::StateInterface> state_interfaces;
+    state_interfaces.emplace_back(
+      hardware_interface::StateInterface(joint_name_, "position", &position_state_));
+    return state_interfaces;
+  }
+
+  std::vector<hardware_interface::CommandInterface> export_command_interfaces() override
+  {
+    std::vector<hardware_interface::CommandInterface> command_interfaces;
+    command_interfaces.emplace_back(
+      hardware_interface::CommandInterface(joint_name_, "position", &position_command_));
+    return command_interfaces;
+  }
+
+  hardware_interface::return_type perform_command_mode_switch(
+    const std::vector<std::string> &, const std::vector<std::string> &) override
+  {
+    mode_switch_thread_ = std::this_thread::get_id();
+    return hardware_interface::return_type::OK;
+  }
+
+  hardware_interface::return_type read() override
+  {
+    position_state_ = position_command_;
+    return hardware_interface::return_type::OK;
+  }
+
+  hardware_interface::return_type write() override { return hardware_interface::return_type::OK; }
+
+  std::string joint_name_;
+  double position_state_ = 0.0;
+  double position_command_ = 0.0;
+  std::thread::id mode_switch_thread_;
+};
+
+TEST_F(TestResourceManager, async_components_are_only_accessed_by_their_own_threads)
+{
+  hardware_interface::ResourceManager rm;
+  std::vector<LoopbackSystem *> systems;
+  for (const auto & name : {"AsyncLoopbackSystem1", "AsyncLoopbackSystem2"})
+  {
+    hardware_interface::HardwareInfo async_hw_info;
+    async_hw_info.name = name;
+    async_hw_info.type = "system";
+    async_hw_info.is_async = true;
+    async_hw_info.rw_rate = 1000;
+    // importing the second system must not move the first one while its thread uses it
+    auto system = std::make_unique<LoopbackSystem>(std::string(name) + "_joint");
+    systems.push_back(system.get());
+    rm.import_component(std::move(system), async_hw_info);
+  }
+  activate_components(rm, {"AsyncLoopbackSystem1", "AsyncLoopbackSystem2"});
+
+  auto command1 = rm.claim_command_interface("AsyncLoopbackSystem1_joint/position");
+  auto command2 = rm.claim_command_interface("AsyncLoopbackSystem2_joint/position");
+  auto state1 = rm.claim_state_interface("AsyncLoopbackSystem1_joint/position");
+  auto state2 = rm.claim_state_interface("AsyncLoopbackSystem2_joint/position");
+  command1.set_value(1.5);
+  command2.set_value(2.5);
+  rm.write();
+  for (int i = 0; i < 1000 && (state1.get_value() != 1.5 || state2.get_value() != 2.5); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    rm.read();
+  }
+  EXPECT_EQ(1.5, state1.get_value());
+  EXPECT_EQ(2.5, state2.get_value());
+
+  // the update loop only requests the mode switch, the threads perform it
+  const std::vector<std::string> start_interfaces = {"AsyncLoopbackSystem1_joint/position"};
+  ASSERT_TRUE(rm.prepare_command_mode_switch(start_interfaces, {}));
+  ASSERT_TRUE(rm.perform_command_mode_switch(start_interfaces, {}));
+  for (int i = 0; i < 1000 && !rm.is_command_mode_switch_done(start_interfaces); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(rm.is_command_mode_switch_done(start_interfaces));
+  EXPECT_NE(std::thread::id(), systems[0]->mode_switch_thread_);
+  EXPECT_NE(std::this_thread::get_id(), systems[0]->mode_switch_thread_);
+
+  // lifecycle transitions wait for the cycle of the component's thread
+  deactivate_components(rm, {"AsyncLoopbackSystem1", "AsyncLoopbackSystem2"});
+  auto status_map = rm.get_components_status();
+  EXPECT_EQ(
+    status_map["AsyncLoopbackSystem1"].state.id(),
+    lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+  EXPECT_EQ(
+    status_map["AsyncLoopbackSystem2"].state.id(),
+    lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+}
+
+TEST_F(TestResourceManager, interface_values_are_exchanged_around_read_and_write)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.name = "LoopbackActuator";
+  hw_info.type = "actuator";
+  auto actuator = std::make_unique<LoopbackActuator>();
+  const auto & loopback = *actuator;
+  rm.import_component(std::move(actuator), hw_info);
+  activate_components(rm, {"LoopbackActuator"});
+
+  {
+    auto command = rm.claim_command_interface("loopback_joint/position");
+    auto state = rm.claim_state_interface("loopback_joint/position");
+    command.set_value(1.5);
+    rm.read();
+    EXPECT_EQ(0.0, loopback.position_command_);
+    EXPECT_EQ(0.0, state.get_value());
+
+    // the component gets the commands before write and provides the states after read
+    rm.write();
+    EXPECT_EQ(1.5, loopback.position_command_);
+    EXPECT_EQ(0.0, state.get_value());
+    rm.read();
+    EXPECT_EQ(1.5, loopback.position_state_);
+    EXPECT_EQ(1.5, state.get_value());
+  }
+
+  // values are kept when more components are imported
+  for (int i = 0; i < 20; ++i)
+  {
+    hw_info.name = "LoopbackActuator" + std::to_string(i);
+    rm.import_component(
+      std::make_unique<LoopbackActuator>("joint" + std::to_string(i)), hw_info);
+  }
+  EXPECT_EQ(1.5, rm.claim_command_interface("loopback_joint/position").get_value());
+  EXPECT_EQ(1.5, rm.claim_state_interface("loopback_joint/position").get_value());
+  rm.claim_command_interface("loopback_joint/position").set_value(2.5);
+  rm.write();
+  rm.read();
+  EXPECT_EQ(2.5, rm.claim_state_interface("loopback_joint/position").get_value());
+}
+
+TEST_F(TestResourceManager, loaned_interfaces_follow_values_moved_by_imports)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.name = "LoopbackActuator";
+  hw_info.type = "actuator";
+  rm.import_component(std::make_unique<LoopbackActuator>(), hw_info);
+  activate_components(rm, {"LoopbackActuator"});
+  auto command = rm.claim_command_interface("loopback_joint/position");
+  auto state = rm.claim_state_interface("loopback_joint/position");
+
+  // the arena grows and moves its values while the interfaces are loaned
+  for (int i = 0; i < 20; ++i)
+  {
+    hw_info.name = "LoopbackActuator" + std::to_string(i);
+    rm.import_component(
+      std::make_unique<LoopbackActuator>("loopback_joint" + std::to_string(i)), hw_info);
+  }
+
+  command.set_value(2.5);
+  rm.write();
+  rm.read();
+  EXPECT_EQ(2.5, state.get_value());
+  EXPECT_EQ(2.5, command.get_value());
+}
+
+class DigitalIOSystem : public hardware_interface::SystemInterface
+{
+public:
+  std::vector<hardware_interface::StateInterface> export_state_interfaces() override
+  {
+    std::vector<hardware_interface::StateInterface> state_interfaces;
+    state_interfaces.emplace_back(hardware_interface::StateInterface("io", "input", &input_));
+    state_interfaces.emplace_back(hardware_interface::StateInterface("io", "mode", &mode_));
+    return state_interfaces;
+  }
+
+  std::vector<hardware_interface::CommandInterface> export_command_interfaces() override
+  {
+    std::vector<hardware_interface::CommandInterface> command_interfaces;
+    command_interfaces.emplace_back(hardware_interface::CommandInterface("io", "output", &output_));
+    return command_interfaces;
+  }
+
+  hardware_interface::return_type read() override
+  {
+    input_ = output_;
+    mode_ = output_ ? -7 : 7;
+    return hardware_interface::return_type::OK;
+  }
+
+  hardware_interface::return_type write() override { return hardware_interface::return_type::OK; }
+
+  bool input_ = false;
+  int32_t mode_ = 0;
+  bool output_ = false;
+};
+
+TEST_F(TestResourceManager, typed_interface_values_are_exchanged_around_read_and_write)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.name = "DigitalIOSystem";
+  hw_info.type = "system";
+  auto system = std::make_unique<DigitalIOSystem>();
+  const auto & io = *system;
+  rm.import_component(std::move(system), hw_info);
+  activate_components(rm, {"DigitalIOSystem"});
+
+  auto output = rm.claim_command_interface("io/output");
+  auto input = rm.claim_state_interface("io/input");
+  auto mode = rm.claim_state_interface("io/mode");
+  EXPECT_EQ(hardware_interface::HandleDataType::BOOL, output.get_data_type());
+  EXPECT_EQ(hardware_interface::HandleDataType::INT32, mode.get_data_type());
+  EXPECT_THROW(input.get_typed_value<double>(), std::runtime_error);
+
+  output.set_typed_value(true);
+  rm.write();
+  EXPECT_TRUE(io.output_);
+  rm.read();
+  EXPECT_TRUE(input.get_typed_value<bool>());
+  EXPECT_EQ(-7, mode.get_typed_value<int32_t>());
+
+  output.set_typed_value(false);
+  rm.write();
+  rm.read();
+  EXPECT_FALSE(input.get_typed_value<bool>());
+  EXPECT_EQ(7, mode.get_typed_value<int32_t>());
+}
+
+class TactileSensor : public hardware_interface::SensorInterface
+{
+public:
+  std::vector<hardware_interface::StateInterface> export_state_interfaces() override
+  {
+    std::vector<hardware_interface::StateInterface> state_interfaces;
+    state_interfaces.emplace_back(
+      hardware_interface::StateInterface("skin", "taxels", taxels_.data(), taxels_.size()));
+    state_interfaces.emplace_back(
+      hardware_interface::StateInterface("skin", "temperature", &temperature_));
+    return state_interfaces;
+  }
+
+  hardware_interface::return_type read() override
+  {
+    for (size_t i = 0; i < taxels_.size(); ++i)
+    {
+      taxels_[i] = static_cast<double>(i) + temperature_;
+    }
+    return hardware_interface::return_type::OK;
+  }
+
+  std::vector<double> taxels_ = std::vector<double>(1024, 0.0);
+  double temperature_ = 0.5;
+};
+
+TEST_F(TestResourceManager, array_interfaces_are_claimed_as_a_unit)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.name = "TactileSensor";
+  hw_info.type = "sensor";
+  rm.import_component(std::make_unique<TactileSensor>(), hw_info);
+  activate_components(rm, {"TactileSensor"});
+
+  EXPECT_EQ(2u, rm.state_interface_keys().size());
+  auto taxels = rm.claim_state_interface("skin/taxels");
+  auto temperature = rm.claim_state_interface("skin/temperature");
+  ASSERT_EQ(1024u, taxels.get_size());
+
+  rm.read();
+  const auto values = taxels.get_values();
+  ASSERT_EQ(1024u, values.size());
+  EXPECT_EQ(0.5, values[0]);
+  EXPECT_EQ(1023.5, values[1023]);
+  // values following an array interface are not overlapped by it
+  EXPECT_EQ(0.5, temperature.get_value());
+}
+
+TEST_F(TestResourceManager, state_snapshots_are_published_at_the_end_of_read)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.name = "LoopbackActuator";
+  hw_info.type = "actuator";
+  rm.import_component(std::make_unique<LoopbackActuator>(), hw_info);
+  activate_components(rm, {"LoopbackActuator"});
+  EXPECT_FALSE(rm.consume_state_snapshot([](const auto &) {}));
+  EXPECT_TRUE(rm.get_state_snapshot_layout().state_interfaces.empty());
+
+  rm.enable_state_snapshots(2);
+  const auto layout = rm.get_state_snapshot_layout();
+  ASSERT_EQ(1u, layout.state_interfaces.size());
+  ASSERT_EQ(1u, layout.command_interfaces.size());
+  EXPECT_EQ("loopback_joint/position", layout.state_interfaces[0].name);
+  const size_t state_index = layout.state_interfaces[0].index;
+  const size_t command_index = layout.command_interfaces[0].index;
+
+  auto command = rm.claim_command_interface("loopback_joint/position");
+  for (double value : {1.0, 2.0, 3.0})
+  {
+    command.set_value(value);
+    rm.write();
+    rm.read();
+  }
+
+  // the third snapshot is dropped as the ring holds only two snapshots
+  std::vector<uint64_t> versions;
+  std::vector<double> states;
+  const auto consumer = [&](const hardware_interface::StateSnapshot & snapshot)
+  {
+    versions.push_back(snapshot.version);
+    states.push_back(snapshot.values[state_index]);
+    EXPECT_EQ(snapshot.values[state_index], snapshot.values[command_index]);
+  };
+  while (rm.consume_state_snapshot(consumer))
+  {
+  }
+  EXPECT_THAT(versions, ::testing::ElementsAre(1u, 2u));
+  EXPECT_THAT(states, ::testing::ElementsAre(1.0, 2.0));
+
+  rm.read();
+  EXPECT_TRUE(rm.consume_state_snapshot([](const hardware_interface::StateSnapshot & snapshot) {
+    EXPECT_EQ(4u, snapshot.version);
+  }));
+
+  // the ring can not be replaced while the update loop is running
+  EXPECT_THROW(rm.enable_state_snapshots(0), std::runtime_error);
+  EXPECT_THROW(rm.enable_state_snapshots(4), std::runtime_error);
+}
+
+TEST_F(TestResourceManager, bulk_claiming_is_all_or_nothing)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.type = "actuator";
+  for (const auto & joint : {"joint1", "joint2", "joint3"})
+  {
+    hw_info.name = std::string("LoopbackActuator_") + joint;
+    rm.import_component(std::make_unique<LoopbackActuator>(joint), hw_info);
+  }
+  activate_components(
+    rm, {"LoopbackActuator_joint1", "LoopbackActuator_joint2", "LoopbackActuator_joint3"});
+  const std::vector<std::string> keys = {"joint1/position", "joint3/position"};
+
+  {
+    auto command_loans = rm.claim_command_interfaces(keys);
+    ASSERT_EQ(2u, command_loans.size());
+    EXPECT_EQ("joint1/position", command_loans[0].get_full_name());
+    EXPECT_EQ("joint3/position", command_loans[1].get_full_name());
+    EXPECT_TRUE(rm.command_interface_is_claimed("joint1/position"));
+    EXPECT_FALSE(rm.command_interface_is_claimed("joint2/position"));
+    EXPECT_TRUE(rm.command_interface_is_claimed("joint3/position"));
+
+    auto state_loans = rm.claim_state_interfaces(keys);
+    ASSERT_EQ(2u, state_loans.size());
+    EXPECT_EQ("joint1/position", state_loans[0].get_full_name());
+    EXPECT_EQ("joint3/position", state_loans[1].get_full_name());
+  }
+  EXPECT_FALSE(rm.command_interface_is_claimed("joint1/position"));
+  EXPECT_FALSE(rm.command_interface_is_claimed("joint3/position"));
+
+  // no interface is claimed if any of them is already claimed, missing or requested twice
+  {
+    auto claimed_loan = rm.claim_command_interface("joint3/position");
+    EXPECT_THROW(
+      rm.claim_command_interfaces({"joint1/position", "joint2/position", "joint3/position"}),
+      std::runtime_error);
+    EXPECT_FALSE(rm.command_interface_is_claimed("joint1/position"));
+    EXPECT_FALSE(rm.command_interface_is_claimed("joint2/position"));
+  }
+  EXPECT_THROW(
+    rm.claim_command_interfaces({"joint1/position", "joint4/position"}), std::runtime_error);
+  EXPECT_FALSE(rm.command_interface_is_claimed("joint1/position"));
+  EXPECT_THROW(
+    rm.claim_command_interfaces({"joint1/position", "joint2/position", "joint1/position"}),
+    std::runtime_error);
+  EXPECT_FALSE(rm.command_interface_is_claimed("joint1/position"));
+  EXPECT_FALSE(rm.command_interface_is_claimed("joint2/position"));
+  EXPECT_THROW(
+    rm.claim_state_interfaces({"joint1/position", "joint4/position"}), std::runtime_error);
+
+  EXPECT_EQ(3u, rm.claim_command_interfaces(rm.available_command_interfaces()).size());
+}
+
 TEST_F(TestResourceManager, default_prepare_perform_switch)
 {
   hardware_interface::ResourceManager rm(ros2_control_test_assets::minimal_robot_urdf);
@@ -339,33 +804,9 @@ TEST_F(TestResourceManager, default_prepare_perform_switch)
   EXPECT_TRUE(rm.perform_command_mode_switch({""}, {""}));
 }
 
-const auto hardware_resources_command_modes =
-  R"(
-  <ros2_control name="TestSystemCommandModes" type="system">
-    <hardware>
-      <plugin>test_hardware_components/TestSystemCommandModes</plugin>
-    </hardware>
-    <joint name="joint1">
-      <command_interface name="position"/>
-      <command_interface name="velocity"/>
-      <state_interface name="position"/>
-      <state_interface name="velocity"/>
-    </joint>
-    <joint name="joint2">
-      <command_interface name="position"/>
-      <command_interface name="velocity"/>
-      <state_interface name="position"/>
-      <state_interface name="velocity"/>
-    </joint>
-  </ros2_control>
-)";
-const auto command_mode_urdf = std::string(ros2_control_test_assets::urdf_head) +
-                               std::string(hardware_resources_command_modes) +
-                               std::string(ros2_control_test_assets::urdf_tail);
-
 TEST_F(TestResourceManager, custom_prepare_perform_switch)
 {
-  hardware_interface::ResourceManager rm(command_mode_urdf);
+  hardware_interface::ResourceManager rm(ros2_control_test_assets::command_modes_robot_urdf);
   // Scenarios defined by example criteria
   std::vector<std::string> empty_keys = {};
   std::vector<std::string> irrelevant_keys = {"elbow_joint/position", "should_joint/position"};
@@ -397,6 +838,18 @@ TEST_F(TestResourceManager, custom_prepare_perform_switch)
   EXPECT_TRUE(rm.perform_command_mode_switch(legal_keys_position, legal_keys_position));
   EXPECT_FALSE(rm.perform_command_mode_switch(empty_keys, empty_keys));
   EXPECT_FALSE(rm.perform_command_mode_switch(empty_keys, legal_keys_position));
+
+  // The test hardware completes the switch to velocity mode in the following read
+  activate_components(rm);
+  EXPECT_TRUE(rm.perform_command_mode_switch(legal_keys_position, legal_keys_velocity));
+  EXPECT_TRUE(rm.is_command_mode_switch_done(legal_keys_position));
+  EXPECT_TRUE(rm.perform_command_mode_switch(legal_keys_velocity, legal_keys_position));
+  EXPECT_FALSE(rm.is_command_mode_switch_done(legal_keys_velocity));
+  EXPECT_FALSE(rm.is_command_mode_switch_done({"joint2/velocity"}));
+  EXPECT_TRUE(rm.is_command_mode_switch_done(legal_keys_position));
+  EXPECT_TRUE(rm.is_command_mode_switch_done(irrelevant_keys));
+  rm.read();
+  EXPECT_TRUE(rm.is_command_mode_switch_done(legal_keys_velocity));
 }
 
 TEST_F(TestResourceManager, resource_status)
@@ -1197,3 +1650,273 @@ TEST_F(TestResourceManager, resource_availability_and_claiming_in_lifecycle)
       std::bind(&hardware_interface::ResourceManager::state_interface_exists, &rm, _1), true);
   }
 }
+
+TEST_F(TestResourceManager, read_write_execution_statistics)
+{
+  hardware_interface::ResourceManager rm(ros2_control_test_assets::minimal_robot_urdf);
+  activate_components(rm);
+
+  auto check_statistics = [&rm](uint64_t expected_count) {
+    auto status_map = rm.get_components_status();
+    for (const auto & name :
+         {TEST_ACTUATOR_HARDWARE_NAME, TEST_SENSOR_HARDWARE_NAME, TEST_SYSTEM_HARDWARE_NAME})
+    {
+      const auto & read_statistics = status_map[name].read_statistics;
+      EXPECT_EQ(expected_count, read_statistics.count) << name;
+      EXPECT_LE(read_statistics.last, read_statistics.max) << name;
+      EXPECT_LE(read_statistics.mean, read_statistics.max) << name;
+      EXPECT_EQ(0u, read_statistics.timeout_count) << name;
+    }
+    EXPECT_EQ(expected_count, status_map[TEST_ACTUATOR_HARDWARE_NAME].write_statistics.count);
+    EXPECT_EQ(expected_count, status_map[TEST_SYSTEM_HARDWARE_NAME].write_statistics.count);
+    // sensors are never written
+    EXPECT_EQ(0u, status_map[TEST_SENSOR_HARDWARE_NAME].write_statistics.count);
+  };
+
+  rm.set_read_write_timeout(std::chrono::seconds(1));
+  for (int i = 0; i < 10; ++i)
+  {
+    rm.read();
+    rm.write();
+  }
+  check_statistics(10u);
+
+  // components are executed in parallel, the statistics keep accumulating
+  rm.enable_parallel_read_write();
+  for (int i = 0; i < 10; ++i)
+  {
+    rm.read();
+    rm.write();
+  }
+  check_statistics(20u);
+}
+
+TEST_F(TestResourceManager, components_imported_after_enabling_parallel_read_write_are_executed)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.name = "ParallelActuator";
+  hw_info.type = "actuator";
+  rm.import_component(std::make_unique<LoopbackActuator>("parallel_joint"), hw_info);
+  activate_components(rm, {"ParallelActuator"});
+
+  // the threads are created once
+  ASSERT_TRUE(rm.enable_parallel_read_write());
+  EXPECT_FALSE(rm.enable_parallel_read_write());
+
+  // read and written by the thread calling read() and write()
+  hw_info.name = "LateActuator";
+  rm.import_component(std::make_unique<LoopbackActuator>("late_joint"), hw_info);
+  activate_components(rm, {"LateActuator"});
+
+  auto parallel_command = rm.claim_command_interface("parallel_joint/position");
+  auto late_command = rm.claim_command_interface("late_joint/position");
+  auto parallel_state = rm.claim_state_interface("parallel_joint/position");
+  auto late_state = rm.claim_state_interface("late_joint/position");
+  parallel_command.set_value(1.0);
+  late_command.set_value(2.0);
+  rm.write();
+  rm.read();
+  EXPECT_EQ(1.0, parallel_state.get_value());
+  EXPECT_EQ(2.0, late_state.get_value());
+
+  auto status_map = rm.get_components_status();
+  EXPECT_EQ(1u, status_map["ParallelActuator"].read_statistics.count);
+  EXPECT_EQ(1u, status_map["LateActuator"].read_statistics.count);
+}
+
+class BlockingActuator : public LoopbackActuator
+{
+public:
+  explicit BlockingActuator(const std::string & joint_name) : LoopbackActuator(joint_name) {}
+
+  hardware_interface::return_type read() override
+  {
+    while (block_.load())
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return LoopbackActuator::read();
+  }
+
+  std::atomic_bool block_{false};
+};
+
+TEST_F(TestResourceManager, late_parallel_components_are_skipped_without_accessing_values)
+{
+  hardware_interface::ResourceManager rm;
+  hardware_interface::HardwareInfo hw_info;
+  hw_info.name = "BlockingActuator";
+  hw_info.type = "actuator";
+  auto actuator = std::make_unique<BlockingActuator>("blocking_joint");
+  auto * blocking_actuator = actuator.get();
+  rm.import_component(std::move(actuator), hw_info);
+  activate_components(rm, {"BlockingActuator"});
+  ASSERT_TRUE(rm.enable_parallel_read_write());
+  rm.set_read_write_timeout(std::chrono::milliseconds(5));
+
+  auto command = rm.claim_command_interface("blocking_joint/position");
+  auto state = rm.claim_state_interface("blocking_joint/position");
+  command.set_value(1.0);
+  rm.write();
+
+  // the read exceeds the timeout and is still running during the write of the cycle
+  blocking_actuator->block_ = true;
+  rm.read();
+  rm.write();
+  auto status_map = rm.get_components_status();
+  EXPECT_EQ(1u, status_map["BlockingActuator"].read_statistics.timeout_count);
+  EXPECT_EQ(0u, status_map["BlockingActuator"].write_statistics.timeout_count);
+  EXPECT_EQ(1u, status_map["BlockingActuator"].write_statistics.count);
+  EXPECT_EQ(1u, status_map["BlockingActuator"].skipped_cycles);
+
+  // the late read does not update the values used by the update loop
+  blocking_actuator->block_ = false;
+  for (int i = 0; i < 1000 && status_map["BlockingActuator"].read_statistics.count == 0u; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    status_map = rm.get_components_status();
+  }
+  EXPECT_EQ(0.0, state.get_value());
+  for (int i = 0; i < 1000 && state.get_value() != 1.0; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    rm.read();
+  }
+  EXPECT_EQ(1.0, state.get_value());
+}
+
+class FailingActuator : public hardware_interface::ActuatorInterface
+{
+public:
+  explicit FailingActuator(const std::string & joint_name) : joint_name_(joint_name) {}
+
+  std::vector<hardware_interface::StateInterface> export_state_interfaces() override
+  {
+    std::vector<hardware_interface::StateInterface> state_interfaces;
+    state_interfaces.emplace_back(
+      hardware_interface::StateInterface(joint_name_, "position", &position_));
+    return state_interfaces;
+  }
+
+  std::vector<hardware_interface::CommandInterface> export_command_interfaces() override
+  {
+    return {};
+  }
+
+  hardware_interface::return_type read() override
+  {
+    return fail_ ? hardware_interface::return_type::ERROR : hardware_interface::return_type::OK;
+  }
+
+  hardware_interface::return_type write() override { return hardware_interface::return_type::OK; }
+
+  std::string joint_name_;
+  double position_ = 0.0;
+  bool fail_ = true;
+};
+
+TEST_F(TestResourceManager, error_policies_are_applied_to_failing_components)
+{
+  using hardware_interface::HardwareErrorAction;
+  hardware_interface::ResourceManager rm;
+  std::unordered_map<std::string, FailingActuator *> actuators;
+  for (const std::string name :
+       {"DefaultActuator", "RetryingActuator", "SkippingActuator", "DeactivatedActuator",
+        "StoppingActuator"})
+  {
+    auto actuator = std::make_unique<FailingActuator>(name + "_joint");
+    actuators[name] = actuator.get();
+    hardware_interface::HardwareInfo hardware_info;
+    hardware_info.name = name;
+    hardware_info.type = "actuator";
+    rm.import_component(std::move(actuator), hardware_info);
+  }
+  activate_components(rm, {"DefaultActuator", "RetryingActuator", "SkippingActuator",
+                           "DeactivatedActuator", "StoppingActuator"});
+
+  EXPECT_FALSE(rm.set_error_policy("UnknownActuator", {}));
+  ASSERT_TRUE(rm.set_error_policy("RetryingActuator", {HardwareErrorAction::RETRY, 2, 0}));
+  ASSERT_TRUE(rm.set_error_policy("SkippingActuator", {HardwareErrorAction::SKIP, 2, 3}));
+  ASSERT_TRUE(rm.set_error_policy("DeactivatedActuator", {HardwareErrorAction::DEACTIVATE, 1, 0}));
+  ASSERT_TRUE(
+    rm.set_error_policy("StoppingActuator", {HardwareErrorAction::STOP_CONTROLLERS, 3, 0}));
+
+  for (int cycle = 0; cycle < 5; ++cycle)
+  {
+    rm.read();
+    rm.write();
+  }
+  EXPECT_THAT(
+    rm.take_failed_components(),
+    ::testing::UnorderedElementsAre("DeactivatedActuator", "StoppingActuator"));
+  EXPECT_TRUE(rm.take_failed_components().empty());
+
+  auto status_map = rm.get_components_status();
+  // the first failed read triggered the error transition
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_UNCONFIGURED,
+    status_map["DefaultActuator"].state.id());
+  EXPECT_EQ(1u, status_map["DefaultActuator"].read_statistics.error_count);
+  // retried in every cycle
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, status_map["RetryingActuator"].state.id());
+  EXPECT_EQ(5u, status_map["RetryingActuator"].read_statistics.error_count);
+  // skipped for 3 cycles after failing in 2
+  EXPECT_EQ(2u, status_map["SkippingActuator"].read_statistics.count);
+  EXPECT_EQ(3u, status_map["SkippingActuator"].skipped_cycles);
+  // halted by the first failed read, not even written in that cycle
+  EXPECT_TRUE(status_map["DeactivatedActuator"].is_halted);
+  EXPECT_EQ(1u, status_map["DeactivatedActuator"].read_statistics.count);
+  EXPECT_EQ(0u, status_map["DeactivatedActuator"].write_statistics.count);
+  // reported once, but still read and written
+  EXPECT_FALSE(status_map["StoppingActuator"].is_halted);
+  EXPECT_EQ(5u, status_map["StoppingActuator"].read_statistics.count);
+  EXPECT_EQ(
+    HardwareErrorAction::STOP_CONTROLLERS, status_map["StoppingActuator"].error_policy.action);
+
+  // a halted component is read again once it is activated again
+  actuators["DeactivatedActuator"]->fail_ = false;
+  deactivate_components(rm, {"DeactivatedActuator"});
+  activate_components(rm, {"DeactivatedActuator"});
+  rm.read();
+  rm.write();
+  status_map = rm.get_components_status();
+  EXPECT_FALSE(status_map["DeactivatedActuator"].is_halted);
+  EXPECT_EQ(2u, status_map["DeactivatedActuator"].read_statistics.count);
+  EXPECT_TRUE(rm.take_failed_components().empty());
+}
+
+TEST_F(TestResourceManager, timeouts_only_fail_cycles_if_the_error_policy_says_so)
+{
+  using hardware_interface::HardwareErrorAction;
+  hardware_interface::ResourceManager rm;
+  for (const std::string name : {"DefaultActuator", "TimeoutFailingActuator"})
+  {
+    auto actuator = std::make_unique<FailingActuator>(name + "_joint");
+    actuator->fail_ = false;
+    hardware_interface::HardwareInfo hardware_info;
+    hardware_info.name = name;
+    hardware_info.type = "actuator";
+    rm.import_component(std::move(actuator), hardware_info);
+  }
+  activate_components(rm, {"DefaultActuator", "TimeoutFailingActuator"});
+  ASSERT_TRUE(rm.set_error_policy(
+    "TimeoutFailingActuator", {HardwareErrorAction::ERROR_TRANSITION, 1, 0, true}));
+
+  // every read and write exceeds the timeout
+  rm.set_read_write_timeout(std::chrono::nanoseconds(1));
+  rm.read();
+  rm.write();
+
+  auto status_map = rm.get_components_status();
+  // a slow cycle is only counted by default
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE, status_map["DefaultActuator"].state.id());
+  EXPECT_EQ(1u, status_map["DefaultActuator"].read_statistics.timeout_count);
+  EXPECT_FALSE(status_map["DefaultActuator"].error_policy.timeouts_fail_cycle);
+  EXPECT_EQ(
+    lifecycle_msgs::msg::State::PRIMARY_STATE_UNCONFIGURED,
+    status_map["TimeoutFailingActuator"].state.id());
+  EXPECT_TRUE(status_map["TimeoutFailingActuator"].error_policy.timeouts_fail_cycle);
+}
@@ -0,0 +1,95 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "hardware_interface/ring_buffer.hpp"
+
+using hardware_interface::RingBuffer;
+
+TEST(TestRingBuffer, reader_takes_published_values_in_order)
+{
+  RingBuffer<std::vector<double>> ring(2, std::vector<double>(2, 0.0));
+  EXPECT_EQ(2u, ring.capacity());
+  EXPECT_EQ(nullptr, ring.front());
+
+  *ring.back() = {1.0, 2.0};
+  ring.publish();
+  *ring.back() = {3.0, 4.0};
+  ring.publish();
+
+  // the ring is full until the reader takes a value
+  EXPECT_EQ(nullptr, ring.back());
+  ASSERT_NE(nullptr, ring.front());
+  EXPECT_THAT(*ring.front(), ::testing::ElementsAre(1.0, 2.0));
+  ring.pop();
+  ASSERT_NE(nullptr, ring.back());
+  *ring.back() = {5.0, 6.0};
+  ring.publish();
+
+  EXPECT_THAT(*ring.front(), ::testing::ElementsAre(3.0, 4.0));
+  ring.pop();
+  EXPECT_THAT(*ring.front(), ::testing::ElementsAre(5.0, 6.0));
+  ring.pop();
+  EXPECT_EQ(nullptr, ring.front());
+}
+
+TEST(TestRingBuffer, concurrent_reader_gets_every_value_which_is_not_dropped)
+{
+  constexpr int kValueCount = 64;
+  constexpr int kPublishCount = 100000;
+  RingBuffer<std::vector<int>> ring(16, std::vector<int>(kValueCount, 0));
+  std::atomic_bool writer_done{false};
+  int dropped = 0;
+
+  std::thread writer([&]() {
+    for (int i = 1; i <= kPublishCount; ++i)
+    {
+      auto * values = ring.back();
+      if (!values)
+      {
+        ++dropped;
+        continue;
+      }
+      for (auto & value : *values)
+      {
+        value = i;
+      }
+      ring.publish();
+    }
+    writer_done = true;
+  });
+
+  int last_value = 0;
+  int received = 0;
+  bool done = false;
+  while (!done)
+  {
+    done = writer_done.load();
+    while (const auto * values = ring.front())
+    {
+      ASSERT_THAT(*values, ::testing::Each(values->front()));
+      EXPECT_GT(values->front(), last_value);
+      last_value = values->front();
+      ++received;
+      ring.pop();
+    }
+  }
+  writer.join();
+  EXPECT_EQ(kPublishCount, received + dropped);
+}
@@ -0,0 +1,83 @@
+// Copyright 2022 ros2_control Development Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "hardware_interface/triple_buffer.hpp"
+
+using hardware_interface::TripleBuffer;
+
+TEST(TestTripleBuffer, reader_gets_latest_published_value)
+{
+  TripleBuffer<std::vector<double>> buffer(std::vector<double>(2, 0.0));
+  EXPECT_FALSE(buffer.fetch());
+  EXPECT_THAT(buffer.front(), ::testing::ElementsAre(0.0, 0.0));
+
+  buffer.back() = {1.0, 2.0};
+  buffer.publish();
+  buffer.back() = {3.0, 4.0};
+  buffer.publish();
+
+  // the first publish is overwritten
+  EXPECT_TRUE(buffer.fetch());
+  EXPECT_THAT(buffer.front(), ::testing::ElementsAre(3.0, 4.0));
+  EXPECT_FALSE(buffer.fetch());
+  EXPECT_THAT(buffer.front(), ::testing::ElementsAre(3.0, 4.0));
+
+  buffer.back() = {5.0, 6.0};
+  buffer.publish();
+  EXPECT_TRUE(buffer.fetch());
+  EXPECT_THAT(buffer.front(), ::testing::ElementsAre(5.0, 6.0));
+}
+
+TEST(TestTripleBuffer, concurrent_reader_never_sees_torn_values)
+{
+  constexpr int kValueCount = 64;
+  constexpr int kPublishCount = 100000;
+  TripleBuffer<std::vector<int>> buffer(std::vector<int>(kValueCount, 0));
+  std::atomic_bool writer_done{false};
+
+  std::thread writer([&]() {
+    for (int i = 1; i <= kPublishCount; ++i)
+    {
+      auto & values = buffer.back();
+      for (auto & value : values)
+      {
+        value = i;
+      }
+      buffer.publish();
+    }
+    writer_done = true;
+  });
+
+  int last_value = 0;
+  bool done = false;
+  while (!done)
+  {
+    done = writer_done.load();
+    if (buffer.fetch())
+    {
+      const auto & values = buffer.front();
+      ASSERT_THAT(values, ::testing::Each(values.front()));
+      EXPECT_GT(values.front(), last_value);
+      last_value = values.front();
+    }
+  }
+  writer.join();
+  EXPECT_EQ(kPublishCount, last_value);
+}
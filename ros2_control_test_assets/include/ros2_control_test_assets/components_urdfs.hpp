@@ -398,6 +398,20 @@ const auto valid_urdf_ros2_control_system_robot_with_size_and_data_type =
   </ros2_control>
 )";
 
+// 12. Sensor read asynchronously at its own rate
+const auto valid_urdf_ros2_control_async_sensor =
+  R"(
+  <ros2_control name="AsyncForceTorqueSensor" type="sensor" is_async="true" rw_rate="100">
+    <hardware>
+      <plugin>ros2_control_demo_hardware/ForceTorqueSensor2DHardware</plugin>
+    </hardware>
+    <sensor name="tcp_fts_sensor">
+      <state_interface name="fx"/>
+      <state_interface name="tz"/>
+    </sensor>
+  </ros2_control>
+)";
+
 // Errors
 const auto invalid_urdf_ros2_control_invalid_child =
   R"(
@@ -526,6 +540,18 @@ const auto invalid_urdf2_ros2_control_illegal_size2 =
   </ros2_control>
 )";
 
+const auto invalid_urdf_ros2_control_async_missing_rate =
+  R"(
+  <ros2_control name="AsyncForceTorqueSensor" type="sensor" is_async="true">
+    <hardware>
+      <plugin>ros2_control_demo_hardware/ForceTorqueSensor2DHardware</plugin>
+    </hardware>
+    <sensor name="tcp_fts_sensor">
+      <state_interface name="fx"/>
+    </sensor>
+  </ros2_control>
+)";
+
 const auto invalid_urdf2_hw_transmission_joint_mismatch =
   R"(
   <ros2_control name="ActuatorModularJoint1" type="actuator">
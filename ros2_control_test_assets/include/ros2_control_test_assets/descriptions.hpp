@@ -175,6 +175,49 @@ const auto hardware_resources =
   </ros2_control>
 )";
 
+const auto hardware_resources_with_command_modes =
+  R"(
+  <ros2_control name="TestSystemCommandModes" type="system">
+    <hardware>
+      <plugin>test_hardware_components/TestSystemCommandModes</plugin>
+    </hardware>
+    <joint name="joint1">
+      <command_interface name="position"/>
+      <command_interface name="velocity"/>
+      <state_interface name="position"/>
+      <state_interface name="velocity"/>
+    </joint>
+    <joint name="joint2">
+      <command_interface name="position"/>
+      <command_interface name="velocity"/>
+      <state_interface name="position"/>
+      <state_interface name="velocity"/>
+    </joint>
+  </ros2_control>
+)";
+
+const auto hardware_resources_with_failing_command_modes =
+  R"(
+  <ros2_control name="TestSystemCommandModes" type="system">
+    <hardware>
+      <plugin>test_hardware_components/TestSystemCommandModes</plugin>
+      <param name="fail_command_mode_switch">true</param>
+    </hardware>
+    <joint name="joint1">
+      <command_interface name="position"/>
+      <command_interface name="velocity"/>
+      <state_interface name="position"/>
+      <state_interface name="velocity"/>
+    </joint>
+    <joint name="joint2">
+      <command_interface name="position"/>
+      <command_interface name="velocity"/>
+      <state_interface name="position"/>
+      <state_interface name="velocity"/>
+    </joint>
+  </ros2_control>
+)";
+
 const auto hardware_resources_missing_state_keys =
   R"(
   <ros2_control name="TestActuatorHardware" type="actuator">
@@ -406,6 +449,14 @@ const auto diffbot_urdf =
 const auto minimal_robot_urdf =
   std::string(urdf_head) + std::string(hardware_resources) + std::string(urdf_tail);
 
+const auto command_modes_robot_urdf = std::string(urdf_head) +
+                                     std::string(hardware_resources_with_command_modes) +
+                                     std::string(urdf_tail);
+
+const auto failing_command_modes_robot_urdf =
+  std::string(urdf_head) + std::string(hardware_resources_with_failing_command_modes) +
+  std::string(urdf_tail);
+
 const auto minimal_robot_missing_state_keys_urdf =
   std::string(urdf_head) + std::string(hardware_resources_missing_state_keys) +
   std::string(urdf_tail);
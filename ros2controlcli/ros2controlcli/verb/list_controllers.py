@@ -41,10 +41,16 @@ class ListControllersVerb(VerbExtension):
             action='store_true',
             help='List controller\'s required command interfaces',
         )
+        parser.add_argument(
+            '--update-statistics',
+            action='store_true',
+            help='List execution time statistics of controller\'s update method',
+        )
         parser.add_argument(
             '--verbose', '-v',
             action='store_true',
-            help='List controller\'s claimed interfaces, required state interfaces and required command interfaces',
+            help='List controller\'s claimed interfaces, required state interfaces, required command '
+                 'interfaces and update statistics',
         )
         add_controller_mgr_parsers(parser)
 
@@ -65,5 +71,14 @@ class ListControllersVerb(VerbExtension):
                     print('\trequired state interfaces:')
                     for required_state_interface in c.required_state_interfaces:
                         print(f'\t\t{required_state_interface}')
+                if args.update_statistics or args.verbose:
+                    stats = c.update_statistics
+                    print('\tupdate statistics:')
+                    print(f'\t\tupdates: {stats.update_count}')
+                    print(f'\t\tlast: {stats.last * 1e3:.3f} ms')
+                    print(f'\t\tmean: {stats.mean * 1e3:.3f} ms')
+                    print(f'\t\tmax: {stats.max * 1e3:.3f} ms')
+                    print(f'\t\toverruns of {stats.budget * 1e3:.3f} ms budget: '
+                          f'{stats.overrun_count}')
 
             return 0
@@ -0,0 +1,77 @@
+# Copyright 2022 ros2_control Development Team
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from controller_manager import set_active_controllers
+
+from ros2cli.node.direct import add_arguments
+from ros2cli.node.strategy import NodeStrategy
+from ros2cli.verb import VerbExtension
+
+from ros2controlcli.api import add_controller_mgr_parsers, LoadedControllerNameCompleter
+
+
+class SetActiveControllersVerb(VerbExtension):
+    """Switch a controller manager to a set of active controllers in one step."""
+
+    def add_arguments(self, parser, cli_name):
+        add_arguments(parser)
+        arg = parser.add_argument(
+            'active',
+            nargs='*',
+            default=[],
+            help='Name of the controllers to be active, unconfigured ones are configured',
+        )
+        arg.completer = LoadedControllerNameCompleter()
+        arg = parser.add_argument(
+            '--inactive',
+            nargs='*',
+            default=[],
+            help='Name of the controllers to be inactive',
+        )
+        arg.completer = LoadedControllerNameCompleter(['active'])
+        parser.add_argument(
+            '--exclusive', action='store_true',
+            help='Stop all active controllers which are not given as active')
+        parser.add_argument('--strict', action='store_true', help='Strict switch')
+        parser.add_argument('--start-asap', action='store_true', help='Start asap controllers')
+        parser.add_argument(
+            '--switch-timeout',
+            default=5.0,
+            type=float,
+            required=False,
+            help='Timeout for switching controllers',
+        )
+        add_controller_mgr_parsers(parser)
+
+    def main(self, *, args):
+        with NodeStrategy(args) as node:
+            response = set_active_controllers(
+                node,
+                args.controller_manager,
+                args.active,
+                args.inactive,
+                args.exclusive,
+                args.strict,
+                args.start_asap,
+                args.switch_timeout,
+            )
+            if not response.ok:
+                return 'Error switching controllers, check controller_manager logs'
+
+            for controller in response.stopped_controllers:
+                print(f'stopped {controller}')
+            for controller in response.started_controllers:
+                print(f'started {controller}')
+            print('Successfully switched controllers')
+            return 0
@@ -43,6 +43,8 @@ ROS2 Control command  interface.""",
             'load_controller = ros2controlcli.verb.load_controller:LoadControllerVerb',
             'reload_controller_libraries = \
                 ros2controlcli.verb.reload_controller_libraries:ReloadControllerLibrariesVerb',
+            'set_active_controllers = \
+                ros2controlcli.verb.set_active_controllers:SetActiveControllersVerb',
             'set_controller_state = \
                 ros2controlcli.verb.set_controller_state:SetControllerStateVerb',
             'switch_controllers = ros2controlcli.verb.switch_controllers:SwitchControllersVerb',